@@ -3,11 +3,17 @@
 
 #define LIST_VERIFICATION 1
 
+/// Fill payloads of free slots with LIST_POISON, costs O(capacity) on clear and growth
+#if !defined(NDEBUG) && !defined(LIST_POISONING)
+# define LIST_POISONING 1
+#endif
+
 #include <stdint.h>
 
 const int64_t LIST_POISON = 0x0FACEFABDDFAC;
 const size_t MIN_LIST_RESERVED = 4;
 const size_t SIZE_MULTIPLIER = 2;
+const int32_t LIST_MAX_RESERVED = INT32_MAX - 1;
 enum listStatus {
     LIST_NULL_PTR_ERROR = -1,
     LIST_SUCCESS = 0,
@@ -23,10 +29,71 @@ enum listStatus {
     LIST_HEAD_ERROR,       ///< Prev[head] != 0         or 0 < iter || iter > reserved
     LIST_TALE_ERROR,       ///< Next[tale] != 0
     LIST_FREE_ERROR,       ///< Prev[free] != -1
+    LIST_ORDER_ERROR,      ///< List is marked linearized, but elements aren't in physical order
+    LIST_FILE_ERROR,       ///< List file can't be written or read, or has wrong format
+};
+
+/// @brief Describes how list grows when it runs out of free slots
+/// newReserved = max(reserved * factor, reserved + step), but no more than reserved + maxStep
+typedef struct listGrowthPolicy {
+    double  factor;     ///< Multiplier of reserved, >= 1
+    int32_t step;       ///< Minimum number of added slots
+    int32_t maxStep;    ///< Maximum number of added slots, 0 = unlimited
+} listGrowthPolicy_t;
+
+const listGrowthPolicy_t LIST_DEFAULT_GROWTH = {SIZE_MULTIPLIER, 0, 0};
+
+/// @brief Capacity that container with reserved slots grows to by policy, at least minReserved
+/// @return Value clamped to maxReserved, so it is < minReserved or <= reserved if container can't grow
+inline int64_t listNextCapacity(const listGrowthPolicy_t *policy, int64_t reserved,
+                                int64_t minReserved, int64_t maxReserved) {
+    // reserved * factor is clamped before the cast, huge factor would overflow int64_t
+    double  scaled      = (double) reserved * policy->factor;
+    int64_t newReserved = (scaled < (double) maxReserved) ? (int64_t) scaled : maxReserved;
+
+    if (newReserved < reserved + policy->step)
+        newReserved = reserved + policy->step;
+    if (policy->maxStep > 0 && newReserved > reserved + policy->maxStep)
+        newReserved = reserved + policy->maxStep;
+    if (newReserved < minReserved)
+        newReserved = minReserved;
+    if (newReserved <= reserved)
+        newReserved = reserved + 1;
+    if (newReserved > maxReserved)
+        newReserved = maxReserved;
+    return newReserved;
+}
+
+/// @brief Describes when operation journal writes and syncs its records
+typedef struct listJournalPolicy {
+    size_t   bufferSize;        ///< Records are written to file when this many bytes are buffered
+    uint32_t recordsPerSync;    ///< fdatasync after this many records, 0 = only in listJournalSync
+} listJournalPolicy_t;
+
+const listJournalPolicy_t LIST_DEFAULT_JOURNAL_POLICY = {1 << 16, 0};
+
+/// @brief Placement of links and payloads in list storage block
+enum listLayout {
+    LIST_LAYOUT_SOA = 0,    ///< Separate next, prev and data arrays
+    LIST_LAYOUT_AOS,        ///< Interleaved {next, prev, payload} nodes
+};
+
+/// @brief How much checking LIST_ASSERT does, set per list at runtime
+enum listVerifyLevel {
+    LIST_VERIFY_OFF = 0,    ///< No checks
+    LIST_VERIFY_LOCAL,      ///< O(1) checks of header and links around touched node
+    LIST_VERIFY_SAMPLED,    ///< Local checks, full listVerify on every verifyPeriod-th check
+    LIST_VERIFY_FULL,       ///< Full listVerify on every check, default
 };
 
 typedef int32_t listIterator_t;
+
+struct listHashIndex;
+struct listJournal;
+struct listStorageShare;
 typedef int (*listPrintFunction_t)(char *buffer, const void *a);
+/// @brief Comparator in qsort style: negative if a < b, 0 if equal, positive if a > b
+typedef int (*listCompare_t)(const void *a, const void *b);
 
 const listIterator_t INVALID_LIST_IT = -1;
 const listIterator_t NULL_LIST_IT = 0;
@@ -35,31 +102,152 @@ typedef struct cList {
     int32_t  reserved;
 
     size_t   elemSize;
-    void    *data;
+    void    *data;      ///< Points inside storage block
+
+    int32_t *next;      ///< Beginning of storage block
+    int32_t *prev;      ///< Points inside storage block
 
-    int32_t *next;
-    int32_t *prev;
+    enum listLayout layout;
+    size_t   linkStride;    ///< Distance between links of adjacent nodes in int32_t
+    size_t   nodeSize;      ///< Distance between payloads of adjacent nodes in bytes
 
     int32_t free;
+    int32_t untouched;  ///< Slots [untouched, reserved] are free, but not initialized and not linked in free
     listPrintFunction_t sPrint;
+
+    bool linearized;    ///< Element k of list is stored in slot k+1, free slots form tail
+    listGrowthPolicy_t growth;
+
+    enum listVerifyLevel verifyLevel;
+    uint32_t verifyPeriod;      ///< Checks between full verifications in LIST_VERIFY_SAMPLED
+    uint32_t verifyCounter;
+
+    struct listHashIndex *index;    ///< Optional hash index for listFind, NULL if disabled
+
+    void    *mapping;       ///< File mapping holding storage block, NULL if block is on heap or shared
+    size_t   mappingSize;
+    struct listStorageShare *shared;    ///< Storage block shared with snapshots, NULL if list owns it alone
+
+    struct listJournal *journal;    ///< Optional journal of modifications, NULL if detached
+    uint64_t generation;            ///< Checkpoint generation, saved in snapshot and journal headers
 } cList_t;
 
+/*------------------LAYOUT INDEPENDENT ACCESS TO NODES------------------------*/
+
+/// @brief Next link of node
+inline int32_t &listNextOf(const cList_t *list, listIterator_t iter) {
+    return list->next[list->linkStride * (size_t) iter];
+}
+
+/// @brief Prev link of node
+inline int32_t &listPrevOf(const cList_t *list, listIterator_t iter) {
+    return list->prev[list->linkStride * (size_t) iter];
+}
+
+/// @brief Payload of node, no checks are made
+inline void *listDataOf(const cList_t *list, listIterator_t iter) {
+    return (char *) list->data + list->nodeSize * (size_t) iter;
+}
+
+/// @brief Check if slot doesn't contain element, iter must be in [1, reserved]
+inline bool listSlotIsFree(const cList_t *list, listIterator_t iter) {
+    return iter >= list->untouched || listPrevOf(list, iter) == INVALID_LIST_IT;
+}
+
 /// @brief Construct list with elements of elemSize
-enum listStatus listCtor(cList_t *list, size_t elemSize, listPrintFunction_t sPrint);
+enum listStatus listCtor(cList_t *list, size_t elemSize, listPrintFunction_t sPrint,
+                         enum listLayout layout = LIST_LAYOUT_SOA);
 
 /// @brief Descturct list
 /// WARNING: listDtor shouldn't be called on destructed or not initialized list
 enum listStatus listDtor(cList_t *list);
 
+/*! @brief Construct dst as deep copy of src, storage block is copied by one memcpy
+    Iterators of src are valid in dst, hash index is rebuilt if src has one, journal isn't copied
+!*/
+enum listStatus listClone(cList_t *dst, const cList_t *src);
+
+/*! @brief Construct snap as frozen view of list in O(1)
+    List and snapshot share storage block until either of them is modified: the first
+    modifying call copies whole block, so each of them sees its own contents afterwards.
+    Snapshot is usual cList_t without index and journal, it is released by listDtor.
+    List and snapshot may be used by different threads, each of them by one thread.
+    Payloads are modified in place through listGetMut, or through listGet, cursors and
+    listForEach only after listMakeWritable, otherwise the write is seen by snapshots too
+!*/
+enum listStatus listSnapshot(cList_t *list, cList_t *snap);
+
+/// @brief Give list its own storage block before payloads are written in place
+/// Copies block if list shares it with snapshots, O(1) otherwise
+enum listStatus listMakeWritable(cList_t *list);
+
 /// @brief Remove all elements from list
+/// O(1) unless LIST_POISONING is defined
 enum listStatus listClear(cList_t *list);
 
+/// @brief Make sure list can store reserved elements without reallocation
+enum listStatus listReserve(cList_t *list, int32_t reserved);
+
+/// @brief Set how list grows when it runs out of free slots
+enum listStatus listSetGrowthPolicy(cList_t *list, listGrowthPolicy_t policy);
+
+/*! @brief Compact elements into low slots and release unused memory
+    @param remap [out] Optional array of reserved + 1 iterators (reserved before call),
+                       remap[old] is new iterator of element or INVALID_LIST_IT for free slots
+    WARNING: iterators above new reserved are invalidated, use remap to fix them
+!*/
+enum listStatus listShrinkToFit(cList_t *list, listIterator_t *remap);
+
+/*! @brief Physically reorder storage into logical order
+    After call element k of list sits in slot k+1 and free slots are [size+1, reserved]
+    WARNING: all iterators of list are invalidated
+!*/
+enum listStatus listLinearize(cList_t *list);
+
+/*! @brief Stable O(n log n) merge sort by relinking next/prev, payloads aren't moved
+    Iterators stay valid and keep pointing to the same values
+!*/
+enum listStatus listSort(cList_t *list, listCompare_t cmp);
+
+/*! @brief Sort list and place elements in physical order in one call
+    After call element k of sorted list sits in slot k+1, so scans are sequential
+    WARNING: all iterators of list are invalidated
+!*/
+enum listStatus listSortLinearize(cList_t *list, listCompare_t cmp);
+
+/*! @brief Move elements [first, last] of src after pos of dst, pos = NULL_LIST_IT moves them to front
+    If src == dst elements are relinked in O(1) after O(k) check of range, iterators stay valid
+    Otherwise storages are independent: payloads are bulk copied into dst and range is freed in src, O(k)
+    WARNING: iterators to moved elements are invalidated if src != dst
+    @return Iterator to first moved elem in dst, INVALID_LIST_IT on error, src and dst aren't changed then
+!*/
+listIterator_t listSplice(cList_t *dst, listIterator_t pos, cList_t *src, listIterator_t first, listIterator_t last);
+
+/// @brief Move elements from iter to tale of list to the end of out, O(moved elements)
+enum listStatus listSplitAt(cList_t *list, listIterator_t iter, cList_t *out);
+
+/*! @brief Merge sorted src into sorted dst, src becomes empty
+    Stable: elements of dst go before equal elements of src, O(dst->size + src->size)
+    On error src is kept, it isn't cleared before all of its elements are copied
+!*/
+enum listStatus listMerge(cList_t *dst, cList_t *src, listCompare_t cmp);
+
 /*! @brief Check list on logic errors
     Prints some info about error
     @return Corresponding error code
 !*/
 enum listStatus listVerify(cList_t *list);
 
+/// @brief O(1) check of list header and links of iter and its neighbours
+/// iter = NULL_LIST_IT checks only header
+enum listStatus listVerifyLocal(cList_t *list, listIterator_t iter);
+
+/// @brief Check list according to its verification level, touched is last modified node or NULL_LIST_IT
+enum listStatus listCheck(cList_t *list, listIterator_t touched);
+
+/// @brief Set verification level of list, period is used only by LIST_VERIFY_SAMPLED
+enum listStatus listSetVerifyLevel(cList_t *list, enum listVerifyLevel level, uint32_t period);
+
 /// @brief Graphical list dump
 /// NOTE: log must be opened in L_HTML_MODE
 enum listStatus listDump(cList_t *list, const char *callMessage);
@@ -98,25 +286,182 @@ listIterator_t listPopBack(cList_t *list);
 /// @brief Remove element by given iterator
 enum listStatus listRemove(cList_t *list, listIterator_t iter);
 
-/// @brief Find first occurrence of elem in list
-/// @return Iterator to found elem, INVALID_LIST_IT otherwise
+/// @brief Remove elements from first to last inclusive
+/// Range is unlinked and returned to free sequence with one splice
+enum listStatus listRemoveRange(cList_t *list, listIterator_t first, listIterator_t last);
+
+/*! @brief Find first occurrence of elem in list
+    Expected O(1) if hash index is enabled and elem is unique,
+    equal elements are ordered by walking the list
+    @return Iterator to found elem, INVALID_LIST_IT otherwise
+!*/
 listIterator_t listFind(cList_t *list, const void *elem);
 
+/*! @brief Find any occurrence of elem, storage is scanned in physical order
+    SoA lists with 4, 8 or 16 byte elements are compared by SIMD blocks
+    @return Iterator to found elem with lowest slot (any found elem if hash index is enabled),
+            INVALID_LIST_IT otherwise
+!*/
+listIterator_t listFindAny(cList_t *list, const void *elem);
+
+/*! @brief Find all occurrences of elem in physical order of slots
+    @param found [out] Array for iterators of found elements, first maxFound of them are written
+    @return Total number of found elements, may be greater than maxFound, -1 on error
+!*/
+int32_t listFindAll(cList_t *list, const void *elem, listIterator_t *found, size_t maxFound);
+
+/*------------------HASH INDEX----------------------------------------------------*/
+// Index maps payload hash to slots and is kept up to date by all list operations,
+// so listFind and listFindAny become expected O(1).
+// WARNING: payloads must not be modified in place through listGet while index is enabled
+
+/// @brief Build hash index of list, O(size)
+enum listStatus listEnableIndex(cList_t *list);
+
+/// @brief Drop hash index of list and free its memory
+enum listStatus listDisableIndex(cList_t *list);
+
+/// @brief Bytes of memory used by hash index, 0 if it is disabled
+size_t listIndexMemory(const cList_t *list);
+
+/*------------------FILE STORAGE----------------------------------------------------*/
+// Links are slot numbers, not pointers, so storage block is written to file as is:
+// page-sized header with format version and list fields, then next, prev and data.
+// Mapped list is usual cList_t over MAP_PRIVATE mapping: pages are read on first
+// access and copied on first write, file itself never changes. Growth or shrink
+// moves storage to heap and unmaps file.
+// File is read on the machine and build it was written by, hash index isn't saved.
+
+/// @brief Write list to path, file is replaced atomically by rename
+/// File and its directory are fsynced, so saved list survives crash once call returns
+enum listStatus listSaveToFile(cList_t *list, const char *path);
+
+/*! @brief Construct list over storage block mapped from file written by listSaveToFile
+    No elements are parsed or copied, load time doesn't depend on list size
+    WARNING: list links are trusted, call listVerify if file may be damaged
+!*/
+enum listStatus listMapFile(cList_t *list, const char *path, listPrintFunction_t sPrint);
+
+/*------------------OPERATION JOURNAL---------------------------------------------*/
+// Journal is append-only file of compact records of every modification: inserts
+// with payloads, removals, clear, splices inside list, linearize, shrink and sorts.
+// Snapshot by listSaveToFile plus journal restore list exactly, with the same
+// iterators, so huge list is saved in full only at checkpoints.
+// Records are buffered and written by one write when buffer fills, fdatasync is
+// done by policy, so durable update costs one sequential write.
+// Journal refuses snapshot that doesn't match state list had when journal was started.
+// Checkpoint increments generation of list and writes it to both headers: snapshot
+// is made durable first, then journal is restarted, so journal of older generation
+// or without complete header means crash in between and snapshot alone is current.
+// WARNING: payloads modified in place through listGet aren't journaled
+
+/// @brief Start journal of list in path, file is truncated
+/// List must be in the state saved by last snapshot, see listJournalCheckpoint
+enum listStatus listJournalAttach(cList_t *list, const char *path,
+                                  listJournalPolicy_t policy = LIST_DEFAULT_JOURNAL_POLICY);
+
+/// @brief Write buffered records and fdatasync journal
+enum listStatus listJournalSync(cList_t *list);
+
+/// @brief Save snapshot to snapshotPath and start journal from scratch
+enum listStatus listJournalCheckpoint(cList_t *list, const char *snapshotPath);
+
+/// @brief Sync and close journal, list itself is unchanged
+enum listStatus listJournalDetach(cList_t *list);
+
+/*! @brief Construct list from snapshot and apply all records of journal to it
+    Torn record at the end of journal (crash during write) ends replay,
+    journal of older generation than snapshot or without header isn't replayed
+    @return LIST_FILE_ERROR if files don't match each other, list isn't constructed then
+!*/
+enum listStatus listJournalReplay(cList_t *list, const char *snapshotPath, const char *journalPath,
+                                  listPrintFunction_t sPrint);
+
 /// @brief Insert after iterator, return iterator to inserted elem
 listIterator_t listInsertAfter(cList_t *list, listIterator_t iter, const void *elem);
 
+/*! @brief Insert count elements from contiguous array after iterator
+    Capacity is reserved once, payloads of adjacent free slots are copied by one memcpy
+    @return Iterator to first inserted elem, NULL_LIST_IT if count == 0, INVALID_LIST_IT on error
+!*/
+listIterator_t listInsertRangeAfter(cList_t *list, listIterator_t iter, const void *elems, size_t count);
+
+/// @brief Push count elements from contiguous array after tale
+/// @return Iterator to first inserted elem, NULL_LIST_IT if count == 0, INVALID_LIST_IT on error
+listIterator_t listPushBackBulk(cList_t *list, const void *elems, size_t count);
+
 /// @brief Insert before iterator, return iterator to inserted elem
 listIterator_t listInsertBefore(cList_t *list, listIterator_t iter, const void *elem);
 
 /// @brief Get value from given list node
 /// @return Pointer to value, NULL otherwise
+/// WARNING: value is shared with snapshots of list, use listGetMut to change it
 void *listGet(cList_t *list, listIterator_t iter);
 
+/// @brief Get value from given list node to change it in place, storage shared with snapshots is copied first
+/// @return Pointer to value, NULL otherwise
+void *listGetMut(cList_t *list, listIterator_t iter);
+
+/// @brief Iterator of element at given position, O(1) if list is linearized
+/// @return Iterator, INVALID_LIST_IT if position is out of range
+listIterator_t listAt(cList_t *list, int32_t position);
+
+/// @brief Position of element in list, O(1) if list is linearized
+/// @return Position starting from 0, -1 if iterator doesn't point to element
+int32_t listIndexOf(cList_t *list, listIterator_t iter);
+
+/*------------------FAST ITERATION--------------------------------------------*/
+/*------------------LIST IS VERIFIED ONCE, STEPS ARE INLINE ARRAY READS--------*/
+
+/// @brief Unchecked cursor over list nodes
+/// WARNING: cursor is invalidated by any operation that modifies list
+typedef struct listCursor {
+    const int32_t *next;    ///< Next array of list
+    size_t         linkStride;
+    char          *data;    ///< Data array of list
+    size_t         nodeSize;
+    listIterator_t iter;    ///< Current node, NULL_LIST_IT after tale
+} listCursor_t;
+
+/// @brief Callback for listForEach, nonzero return value stops traversal
+typedef int (*listVisitor_t)(void *elem, listIterator_t iter, void *ctx);
+
+/// @brief Verify list once and return cursor pointing to head
+/// Returned cursor is already finished if list is empty or broken
+listCursor_t listCursorBegin(cList_t *list);
+
+/// @brief Check if cursor points to element
+inline bool listCursorValid(const listCursor_t *cursor) {
+    return cursor->iter != NULL_LIST_IT;
+}
+
+/// @brief Move cursor to next element
+inline void listCursorNext(listCursor_t *cursor) {
+    cursor->iter = cursor->next[cursor->linkStride * (size_t) cursor->iter];
+}
+
+/// @brief Pointer to value of current element
+inline void *listCursorGet(const listCursor_t *cursor) {
+    return cursor->data + cursor->nodeSize * (size_t) cursor->iter;
+}
+
+/// @brief Call visitor for every element from head to tale
+/// @return Iterator of element where visitor stopped traversal, NULL_LIST_IT otherwise
+inline listIterator_t listForEach(cList_t *list, listVisitor_t visitor, void *ctx) {
+    for (listCursor_t cursor = listCursorBegin(list); listCursorValid(&cursor); listCursorNext(&cursor))
+        if (visitor(listCursorGet(&cursor), cursor.iter, ctx))
+            return cursor.iter;
+    return NULL_LIST_IT;
+}
+
 #if defined(LIST_VERIFICATION) && !defined(NDEBUG)
 
-# define LIST_ASSERT(list)                                                                          \
+# define LIST_ASSERT(list) LIST_ASSERT_NODE(list, NULL_LIST_IT)
+
+/// @brief List assert that also checks links around touched node in LIST_VERIFY_LOCAL mode
+# define LIST_ASSERT_NODE(list, touched)                                                            \
     do {                                                                                            \
-        enum listStatus status = listVerify(list);                                                  \
+        enum listStatus status = listCheck(list, touched);                                          \
         if (status != LIST_SUCCESS) {                                                               \
             logPrint(L_ZERO, 1, "<h2>%s:%d, %s\n", __FILE__, __LINE__, __PRETTY_FUNCTION__);        \
             logPrint(L_ZERO, 1, "List[%p] error occurred. Error code = %d</h2>\n", list, status);   \
@@ -126,9 +471,11 @@ void *listGet(cList_t *list, listIterator_t iter);
     } while(0)
 
 /// @brief List assert used in functions returning custom error values
-# define LIST_CUSTOM_ASSERT(list, ERR_VALUE)                                                        \
+# define LIST_CUSTOM_ASSERT(list, ERR_VALUE) LIST_CUSTOM_ASSERT_NODE(list, NULL_LIST_IT, ERR_VALUE)
+
+# define LIST_CUSTOM_ASSERT_NODE(list, touched, ERR_VALUE)                                          \
     do {                                                                                            \
-        enum listStatus status = listVerify(list);                                                  \
+        enum listStatus status = listCheck(list, touched);                                          \
         if (status != LIST_SUCCESS) {                                                               \
             logPrint(L_ZERO, 1, "<h2>%s:%d, %s\n", __FILE__, __LINE__, __PRETTY_FUNCTION__);        \
             logPrint(L_ZERO, 1, "List[%p] error occurred. Error code = %d</h2>\n", list, status);   \
@@ -139,7 +486,9 @@ void *listGet(cList_t *list, listIterator_t iter);
 
 #else
 # define LIST_ASSERT(list)
+# define LIST_ASSERT_NODE(list, touched)
 # define LIST_CUSTOM_ASSERT(list, ERR_VALUE)
+# define LIST_CUSTOM_ASSERT_NODE(list, touched, ERR_VALUE)
 #endif
 
 #endif
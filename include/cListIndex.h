@@ -0,0 +1,46 @@
+#ifndef C_LIST_INDEX_H
+#define C_LIST_INDEX_H
+
+/*------------------HASH INDEX OF cList_t-------------------------------------*/
+/*------------------INTERNAL HOOKS, CALLED BY cList.cpp-----------------------*/
+// Index is chained hash table without per-node allocations:
+// buckets[hash & bucketMask] is first slot of chain, chain[slot] is next slot,
+// NULL_LIST_IT terminates chains because slot 0 is never element.
+// Public API (listEnableIndex, ...) is declared in cList.h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cList.h"
+
+typedef struct listHashIndex {
+    int32_t *buckets;       ///< First slot of every chain, NULL_LIST_IT if bucket is empty
+    size_t   bucketMask;    ///< Number of buckets - 1, number of buckets is power of two
+    int32_t *chain;         ///< Next slot in the same bucket, indexed by slot
+    size_t   chainSize;     ///< Number of slots chain can hold
+} listHashIndex_t;
+
+/// @brief Add element in slot to index, payload must be already written
+void listIndexInsert(cList_t *list, listIterator_t slot);
+
+/// @brief Remove element in slot from index, payload must be still intact
+void listIndexRemove(cList_t *list, listIterator_t slot);
+
+/// @brief Forget all elements, O(number of buckets)
+void listIndexClear(cList_t *list);
+
+/// @brief Re-add all live elements, called after payloads are moved between slots
+void listIndexRebuild(cList_t *list);
+
+/// @brief Prepare index for list of capacity slots (NULL element included)
+/// Called before storage grows, so failure leaves list and index unchanged
+enum listStatus listIndexReserve(cList_t *list, size_t capacity);
+
+/// @brief Find slot with payload equal to elem, INVALID_LIST_IT if there is none
+/// @param duplicates [out] Set to true if more than one element equals elem
+listIterator_t listIndexLookup(cList_t *list, const void *elem, bool *duplicates);
+
+/// @brief Check that index holds exactly live elements in their buckets
+enum listStatus listIndexVerify(cList_t *list);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef C_LIST_JOURNAL_H
+#define C_LIST_JOURNAL_H
+
+/*------------------OPERATION JOURNAL OF cList_t------------------------------*/
+/*------------------INTERNAL HOOKS, CALLED BY cList.cpp-----------------------*/
+// Journal file: listJournalHeader_t, then records one after another.
+// Every record is listJournalRecord_t followed by count payloads (inserts)
+// or count slots (sorts). Records hold slots, not positions, so replay over
+// the snapshot reproduces the same slots, and every insert checks that.
+// Records are buffered and written when buffer fills or on sync.
+// Public API (listJournalAttach, ...) is declared in cList.h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cList.h"
+
+enum listJournalOp {
+    LIST_JOURNAL_END = 0,           ///< Zeros after torn tail of file look like this
+    LIST_JOURNAL_INSERT,            ///< count payloads inserted after iter into slots from first on
+    LIST_JOURNAL_REMOVE,            ///< Range [first, last] removed
+    LIST_JOURNAL_CLEAR,
+    LIST_JOURNAL_MOVE,              ///< Range [first, last] relinked after iter of the same list
+    LIST_JOURNAL_LINEARIZE,
+    LIST_JOURNAL_SHRINK,
+    LIST_JOURNAL_SORT,              ///< Elements relinked in order of count slots
+    LIST_JOURNAL_SORT_LINEARIZE,    ///< Elements relinked in order of count slots and placed in order
+    LIST_JOURNAL_OP_COUNT
+};
+
+typedef struct listJournalRecord {
+    uint32_t op;
+    int32_t  iter;
+    int32_t  first;
+    int32_t  last;
+    int32_t  count;     ///< Number of payloads or slots following record
+} listJournalRecord_t;
+
+typedef struct listJournal {
+    int      fd;
+    char    *path;
+    listJournalPolicy_t policy;
+
+    char    *buffer;
+    size_t   buffered;
+    uint32_t unsynced;  ///< Records written since last fdatasync
+    bool     failed;    ///< Write failed, records aren't accepted anymore
+} listJournal_t;
+
+/// @brief Record insertion of count elements after iter, elements start from slot first
+void listJournalInsert(cList_t *list, listIterator_t iter, listIterator_t first, int32_t count);
+
+/// @brief Record removal of range [first, last]
+void listJournalRemove(cList_t *list, listIterator_t first, listIterator_t last);
+
+/// @brief Record operation without payloads: clear, move, linearize or shrink
+void listJournalOperation(cList_t *list, enum listJournalOp op, listIterator_t iter,
+                          listIterator_t first, listIterator_t last);
+
+/// @brief Record new order of elements, only next links need to be valid
+void listJournalOrder(cList_t *list, enum listJournalOp op);
+
+/*! @brief Implemented in cList.cpp: link elements in order of count slots,
+           then place them in order if linearize is true, as listSortLinearize does
+    @return LIST_ERROR if order isn't permutation of elements, list is unchanged then
+!*/
+enum listStatus listApplyOrder(cList_t *list, const int32_t *order, int32_t count, bool linearize);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef C_LIST_PARALLEL_H
+#define C_LIST_PARALLEL_H
+
+/*------------------PARALLEL PASSES OVER cList_t------------------------------*/
+// Work is split into one chunk per thread, calling thread processes first chunk.
+// LIST_PARALLEL_ANY_ORDER: chunks are ranges of physical slots, free slots
+//   (prev = INVALID_LIST_IT) are skipped, so nothing is walked by next.
+// LIST_PARALLEL_IN_ORDER: chunks are ranges of logical positions, their first
+//   elements are found by one walk by next (by arithmetic if list is linearized).
+//   Elements of chunk are visited in list order and partial results are combined
+//   in chunk order, so reduction needs to be associative, but not commutative.
+// Threads are created by every call, no state is kept between calls.
+// List must not be modified during call, visitors may run concurrently.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cList.h"
+
+/// Chunks smaller than this aren't worth a thread
+const int32_t LIST_PARALLEL_MIN_CHUNK = 1 << 14;
+
+enum listParallelOrder {
+    LIST_PARALLEL_ANY_ORDER = 0,
+    LIST_PARALLEL_IN_ORDER,
+};
+
+/// @brief Callback of listParallelForEach, may change payload of elem, but not list
+/// Storage shared with snapshots is copied before visitors run, so snapshots don't see changes
+/// WARNING: payloads must not be changed if hash index is enabled
+typedef void (*listElemVisitor_t)(void *elem, listIterator_t iter, void *ctx);
+
+/// @brief Add elem to partial result acc
+typedef void (*listReduceStep_t)(void *acc, const void *elem, void *ctx);
+
+/// @brief Combine partial result of later elements other into acc
+typedef void (*listReduceCombine_t)(void *acc, const void *other, void *ctx);
+
+/*! @brief Call visitor for every element of list from several threads
+    @param threads Number of threads including calling one, 0 = number of hardware threads
+!*/
+enum listStatus listParallelForEach(cList_t *list, listElemVisitor_t visitor, void *ctx,
+                                    enum listParallelOrder order, unsigned threads);
+
+/*! @brief Reduce all elements of list into result from several threads
+    Every thread starts from copy of identity, partial results are combined into result
+    @param resultSize Size of result and identity
+    @param threads    Number of threads including calling one, 0 = number of hardware threads
+!*/
+enum listStatus listParallelReduce(cList_t *list, void *result, size_t resultSize, const void *identity,
+                                   listReduceStep_t step, listReduceCombine_t combine, void *ctx,
+                                   enum listParallelOrder order, unsigned threads);
+
+#endif
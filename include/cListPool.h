@@ -0,0 +1,110 @@
+#ifndef C_LIST_POOL_H
+#define C_LIST_POOL_H
+
+/*------------------SHARED NODE POOL FOR MANY SMALL LISTS---------------------*/
+// listPool_t owns next, prev and data arrays and free sequence of nodes.
+// poolList_t is a light list head (first, last, size) drawing nodes from pool,
+// so list costs no allocations by itself and nodes move between lists of one
+// pool without copying payloads.
+// Scheme is the same as in cList_t, but lists have no own NULL element:
+// node 0 is shared terminator, next of last node and prev of first node are NULL_LIST_IT,
+// free nodes have prev = INVALID_LIST_IT, never used nodes form untouched region.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cList.h"
+
+typedef struct listPool {
+    size_t   elemSize;
+    int32_t *next;
+    int32_t *prev;
+    void    *data;
+
+    int32_t  reserved;      ///< Nodes [1, reserved] belong to pool
+    int32_t  used;          ///< Nodes taken by lists
+    int32_t  free;
+    int32_t  untouched;     ///< Nodes [untouched, reserved] are free, but not initialized and not linked in free
+
+    listGrowthPolicy_t growth;
+} listPool_t;
+
+typedef struct poolList {
+    listPool_t    *pool;
+    listIterator_t first;   ///< NULL_LIST_IT if list is empty
+    listIterator_t last;    ///< NULL_LIST_IT if list is empty
+    int32_t        size;
+} poolList_t;
+
+/// @brief Payload of pool node, no checks are made
+inline void *poolDataOf(const listPool_t *pool, listIterator_t iter) {
+    return (char *) pool->data + pool->elemSize * (size_t) iter;
+}
+
+/// @brief Construct pool of nodes with elements of elemSize
+enum listStatus listPoolCtor(listPool_t *pool, size_t elemSize);
+
+/// @brief Destruct pool, all lists of pool become invalid
+enum listStatus listPoolDtor(listPool_t *pool);
+
+/// @brief Make sure pool has reserved nodes without reallocation
+enum listStatus listPoolReserve(listPool_t *pool, int32_t reserved);
+
+/// @brief Set how pool grows when it runs out of free nodes
+enum listStatus listPoolSetGrowthPolicy(listPool_t *pool, listGrowthPolicy_t policy);
+
+/// @brief Check pool header and free sequence, O(reserved)
+enum listStatus listPoolVerify(listPool_t *pool);
+
+/// @brief Initialize empty list in pool, makes no allocations
+enum listStatus poolListCtor(poolList_t *list, listPool_t *pool);
+
+/// @brief Return all nodes of list to pool
+enum listStatus poolListClear(poolList_t *list);
+
+/// @brief Check links of list, O(size)
+enum listStatus poolListVerify(poolList_t *list);
+
+/// @brief Return first element, NULL_LIST_IT if list is empty
+listIterator_t poolListFront(poolList_t *list);
+
+/// @brief Return last element, NULL_LIST_IT if list is empty
+listIterator_t poolListBack(poolList_t *list);
+
+/// @brief Return next element, NULL_LIST_IT after last one
+listIterator_t poolListNext(poolList_t *list, listIterator_t iter);
+
+/// @brief Return previous element, NULL_LIST_IT before first one
+listIterator_t poolListPrev(poolList_t *list, listIterator_t iter);
+
+/// @brief Get value from given list node
+/// @return Pointer to value, NULL otherwise
+void *poolListGet(poolList_t *list, listIterator_t iter);
+
+/// @brief Insert after iterator, NULL_LIST_IT inserts before first element
+/// @return Iterator to inserted elem, INVALID_LIST_IT on error
+listIterator_t poolListInsertAfter(poolList_t *list, listIterator_t iter, const void *elem);
+
+/// @brief Push elem before first element
+listIterator_t poolListPushFront(poolList_t *list, const void *elem);
+
+/// @brief Push elem after last element
+listIterator_t poolListPushBack(poolList_t *list, const void *elem);
+
+/// @brief Remove element and return its node to pool
+enum listStatus poolListRemove(poolList_t *list, listIterator_t iter);
+
+/*! @brief Move elements [first, last] of src after iter of dest, payloads aren't copied
+    Links are changed in O(1), counting moved elements costs O(last - first)
+    src and dest must share pool, iter = NULL_LIST_IT moves range to front of dest
+    Range is checked to be in src and iter in dest by walking to the nearer end of list,
+    nothing is changed if check fails
+!*/
+enum listStatus poolListSpliceAfter(poolList_t *dest, listIterator_t iter,
+                                    poolList_t *src, listIterator_t first, listIterator_t last);
+
+/// @brief Move all elements of src after iter of dest, src becomes empty
+/// O(1) links change, checking that iter is in dest walks to the nearer end of dest
+enum listStatus poolListSpliceAllAfter(poolList_t *dest, listIterator_t iter, poolList_t *src);
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef C_LIST_QUEUE_H
+#define C_LIST_QUEUE_H
+
+/*------------------LOCK-FREE FIFO ON INDEX-LINKED NODES----------------------*/
+// Queue uses the same scheme as cList_t: nodes are slots of preallocated next
+// and data arrays, linked by indices, node 0 terminates sequences.
+// Queue is bounded, capacity is fixed by constructor, because storage can't be
+// reallocated while other threads read it.
+//
+// Queue sequence always starts with dummy node head, first element is next[head].
+// Consumer copies payload of next[head] and makes it new dummy, so producers
+// and consumer never touch the same link at once.
+//
+// LIST_QUEUE_SPSC: one producer, one consumer, no read-modify-write operations.
+//   Nodes already passed by consumer (from firstFree up to head) are reused by producer.
+//   Producer rereads head only when it runs out of nodes seen as passed, so head's
+//   cache line isn't pulled from consumer on every push.
+// LIST_QUEUE_MPSC: many producers, one consumer.
+//   Producers append by exchange of tail, so push is wait-free when free node is at hand.
+//   Free nodes form stack with tagged head (index in low 32 bits, version in high),
+//   version is bumped by every push, so ABA can't make stale pop succeed.
+//   Consumer may see queue empty while producer is between exchange and link store.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <atomic>
+
+#include "cList.h"
+
+/// Nodes touched by different threads are kept on different cache lines
+const size_t LIST_QUEUE_CACHE_LINE = 64;
+
+enum listQueueMode {
+    LIST_QUEUE_SPSC = 0,
+    LIST_QUEUE_MPSC,
+};
+
+typedef struct listQueue {
+    size_t   elemSize;
+    int32_t  capacity;                  ///< Maximum number of elements, capacity + 1 nodes are allocated
+    enum listQueueMode mode;
+
+    std::atomic<int32_t> *next;         ///< next[node] links queue and free stack, next[0] is unused
+    void                 *data;
+
+    alignas(LIST_QUEUE_CACHE_LINE)
+    std::atomic<int32_t>  head;         ///< Dummy node, written only by consumer
+
+    alignas(LIST_QUEUE_CACHE_LINE)
+    std::atomic<int32_t>  tail;         ///< Last node of queue sequence
+    int32_t               firstFree;    ///< SPSC: oldest node passed by consumer, producer only
+    int32_t               untouched;    ///< SPSC: nodes [untouched, capacity + 1] were never used
+    int32_t               headSeen;     ///< SPSC: head as last loaded by producer, reloaded only at firstFree
+
+    alignas(LIST_QUEUE_CACHE_LINE)
+    std::atomic<uint64_t> freeHead;     ///< MPSC: tagged top of free stack
+} listQueue_t;
+
+/// @brief Construct queue of at most capacity elements of elemSize, all memory is allocated here
+enum listStatus listQueueCtor(listQueue_t *queue, size_t elemSize, int32_t capacity, enum listQueueMode mode);
+
+/// @brief Destruct queue, no thread may use it anymore
+enum listStatus listQueueDtor(listQueue_t *queue);
+
+/*! @brief Append copy of elem, called by producer thread(s)
+    @return false if queue is full
+!*/
+bool listQueueTryPush(listQueue_t *queue, const void *elem);
+
+/*! @brief Copy first element to elem and remove it, called by consumer thread only
+    @return false if queue is empty
+!*/
+bool listQueueTryPop(listQueue_t *queue, void *elem);
+
+/// @brief Check links and count nodes, queue must not be used by other threads during call
+enum listStatus listQueueVerify(listQueue_t *queue);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef C_LIST_SHARED_H
+#define C_LIST_SHARED_H
+
+/*------------------THREAD-SAFE LIST FOR MANY READERS-------------------------*/
+// cList_t itself has no threading model: even reading functions may update
+// verification counters, so one list must not be used by several threads.
+// listShared_t wraps cList_t with reader-writer lock:
+//   readers (Get, Find, ForEach, Size) hold shared lock and use only inline
+//   accessors, so they don't write anything and run concurrently;
+//   writers hold exclusive lock and call usual cList_t functions.
+// Storage is reallocated only under exclusive lock, so growth never happens
+// under reader in flight.
+// Lock is std::shared_mutex, on Linux it prefers readers, so it fits lists
+// that are read often and modified rarely.
+// WARNING: iterators returned by one call may be stale in next one,
+//          slot of removed element may be reused by another writer
+
+#include <stddef.h>
+#include <stdint.h>
+#include <shared_mutex>
+
+#include "cList.h"
+
+typedef struct listShared {
+    cList_t           list;
+    std::shared_mutex lock;
+} listShared_t;
+
+/// @brief Callback for listSharedForEach, nonzero return value stops traversal
+/// Element must not be modified: other readers may see it at the same time
+typedef int (*listSharedVisitor_t)(const void *elem, listIterator_t iter, void *ctx);
+
+/// @brief Callback for listSharedUpdate, called with exclusive lock held
+typedef enum listStatus (*listSharedUpdater_t)(cList_t *list, void *ctx);
+
+/// @brief Construct shared list, arguments are the same as in listCtor
+enum listStatus listSharedCtor(listShared_t *shared, size_t elemSize, listPrintFunction_t sPrint,
+                               enum listLayout layout);
+
+/// @brief Destruct shared list, no thread may use it anymore
+enum listStatus listSharedDtor(listShared_t *shared);
+
+/*------------------WRITERS, EXCLUSIVE LOCK-----------------------------------*/
+
+/// @brief Push elem after tale
+listIterator_t listSharedPushBack(listShared_t *shared, const void *elem);
+
+/// @brief Push elem before head
+listIterator_t listSharedPushFront(listShared_t *shared, const void *elem);
+
+/// @brief Insert after iterator, INVALID_LIST_IT if iterator is invalid
+listIterator_t listSharedInsertAfter(listShared_t *shared, listIterator_t iter, const void *elem);
+
+/// @brief Remove element by given iterator
+enum listStatus listSharedRemove(listShared_t *shared, listIterator_t iter);
+
+/// @brief Copy head element to elem and remove it
+/// @return false if list is empty
+bool listSharedTryPopFront(listShared_t *shared, void *elem);
+
+/// @brief Run several operations on list as one atomic update
+enum listStatus listSharedUpdate(listShared_t *shared, listSharedUpdater_t updater, void *ctx);
+
+/*------------------READERS, SHARED LOCK--------------------------------------*/
+
+/// @brief Number of elements
+int32_t listSharedSize(listShared_t *shared);
+
+/// @brief Copy value of element to elem
+/// @return LIST_ERROR if iterator doesn't point to element
+enum listStatus listSharedGet(listShared_t *shared, listIterator_t iter, void *elem);
+
+/// @brief Find first occurrence of elem, expected O(1) if hash index is enabled and elem is unique
+/// @return Iterator to found elem, INVALID_LIST_IT otherwise
+listIterator_t listSharedFind(listShared_t *shared, const void *elem);
+
+/// @brief Call visitor for every element from head to tale
+/// @return Iterator of element where visitor stopped traversal, NULL_LIST_IT otherwise
+listIterator_t listSharedForEach(listShared_t *shared, listSharedVisitor_t visitor, void *ctx);
+
+#endif
@@ -0,0 +1,664 @@
+#ifndef C_LIST_T_H
+#define C_LIST_T_H
+
+/*------------------TYPED FRONT-END OF cList_t--------------------------------*/
+/*------------------ELEMENT SIZE AND COPY ARE KNOWN AT COMPILE TIME-----------*/
+// clist::cList<T> uses the same scheme as cList_t: node 0 is NULL element
+// (next[0] = head, prev[0] = tale), free slots are linked through next with
+// prev = INVALID_LIST_IT, never used slots form untouched region [untouched, reserved].
+// Payloads are typed, so copies are plain assignments instead of memcpy(elemSize).
+// Width of links is template parameter Index: int16_t halves link memory of lists
+// up to 32766 elements, int64_t lifts the limit of 2^31 - 2 elements of int32_t.
+// C API in cList.h stays type-erased variant of this container.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "error_debug.h"
+#include "logger.h"
+#include "cList.h"
+
+namespace clist {
+
+/*------------------STL ITERATORS---------------------------------------------*/
+// Iterators keep pointers to link and data arrays, steps are inline array reads.
+// end() is NULL element, so --end() is tale. Like std::vector iterators they are
+// invalidated by reallocation of list storage; removal invalidates only removed element.
+
+/*! @brief Bidirectional iterator over links of cList_t with elements of type T
+    T may be const-qualified, strides come from list layout
+!*/
+template <typename T>
+class listLinkIterator {
+public:
+    typedef std::bidirectional_iterator_tag     iterator_category;
+    typedef typename std::remove_cv<T>::type    value_type;
+    typedef ptrdiff_t                           difference_type;
+    typedef T                                  *pointer;
+    typedef T                                  &reference;
+
+    listLinkIterator() noexcept:
+        next(NULL), prev(NULL), linkStride(0), data(NULL), nodeSize(0), iter(NULL_LIST_IT) {}
+
+    listLinkIterator(const cList_t *list, listIterator_t node) noexcept:
+        next(list->next), prev(list->prev), linkStride(list->linkStride),
+        data((char *) list->data), nodeSize(list->nodeSize), iter(node) {}
+
+    /// @brief Const iterator from mutable one
+    template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+    listLinkIterator(const listLinkIterator<U> &other) noexcept:
+        next(other.next), prev(other.prev), linkStride(other.linkStride),
+        data(other.data), nodeSize(other.nodeSize), iter(other.iter) {}
+
+    reference operator*()  const { return *(T *) (data + nodeSize * (size_t) iter); }
+    pointer   operator->() const { return  (T *) (data + nodeSize * (size_t) iter); }
+
+    listLinkIterator &operator++() { iter = next[linkStride * (size_t) iter]; return *this; }
+    listLinkIterator &operator--() { iter = prev[linkStride * (size_t) iter]; return *this; }
+    listLinkIterator  operator++(int) { listLinkIterator old = *this; ++*this; return old; }
+    listLinkIterator  operator--(int) { listLinkIterator old = *this; --*this; return old; }
+
+    bool operator==(const listLinkIterator &other) const { return iter == other.iter; }
+    bool operator!=(const listLinkIterator &other) const { return iter != other.iter; }
+
+    /// @brief Index of node to use with C API
+    listIterator_t index() const { return iter; }
+
+private:
+    template <typename U> friend class listLinkIterator;
+
+    const int32_t *next;
+    const int32_t *prev;
+    size_t         linkStride;
+    char          *data;
+    size_t         nodeSize;
+    listIterator_t iter;
+};
+
+/*! @brief Range over cList_t for range-for and STL algorithms
+    List is verified once on construction
+    Usage: for (double &elem : clist::listView<double>(&list))
+!*/
+template <typename T>
+class listView {
+public:
+    typedef listLinkIterator<T>                 iterator;
+    typedef listLinkIterator<const T>           const_iterator;
+    typedef typename std::remove_cv<T>::type    value_type;
+
+    explicit listView(cList_t *viewed): list(viewed) {
+        MY_ASSERT(viewed, exit(LIST_NULL_PTR_ERROR));
+        MY_ASSERT(viewed->elemSize == sizeof(T), exit(LIST_SIZE_ERROR));
+        // cursor verifies list according to its verification level
+        (void) listCursorBegin(viewed);
+    }
+
+    iterator begin() const { return iterator(list, listNextOf(list, 0)); }
+    iterator end()   const { return iterator(list, NULL_LIST_IT); }
+
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend()   const { return end(); }
+
+    int32_t size() const { return list->size; }
+    bool    empty() const { return list->size == 0; }
+
+private:
+    cList_t *list;
+};
+
+template <typename T, typename Index = int32_t>
+class cList {
+public:
+    typedef T value_type;
+
+    /// Trivially copyable payloads are moved around by realloc, others are move-constructed one by one
+    static const bool relocatable = std::is_trivially_copyable<T>::value;
+
+    static_assert(alignof(T) <= alignof(max_align_t), "over-aligned element types aren't supported");
+    static_assert(std::is_integral<Index>::value && std::is_signed<Index>::value,
+                  "links must be signed integers, -1 marks free slots");
+
+    /// Type of links and iterators
+    typedef Index index_type;
+
+    /// Largest number of elements, slot 0 is NULL element
+    static constexpr Index maxReserved = std::numeric_limits<Index>::max() - 1;
+
+    /// @brief Bidirectional iterator, end() is NULL element, invalidated by reallocation
+    template <bool isConst>
+    class linkIterator {
+    public:
+        typedef std::bidirectional_iterator_tag                         iterator_category;
+        typedef T                                                       value_type;
+        typedef ptrdiff_t                                               difference_type;
+        typedef typename std::conditional<isConst, const T *, T *>::type pointer;
+        typedef typename std::conditional<isConst, const T &, T &>::type reference;
+
+        linkIterator() noexcept: next(NULL), prev(NULL), data(NULL), iter(NULL_LIST_IT) {}
+
+        linkIterator(const Index *nextLinks, const Index *prevLinks, pointer elems, Index node) noexcept:
+            next(nextLinks), prev(prevLinks), data(elems), iter(node) {}
+
+        /// @brief Const iterator from mutable one
+        template <bool otherConst, typename = typename std::enable_if<isConst && !otherConst>::type>
+        linkIterator(const linkIterator<otherConst> &other) noexcept:
+            next(other.next), prev(other.prev), data(other.data), iter(other.iter) {}
+
+        reference operator*()  const { return data[iter]; }
+        pointer   operator->() const { return &data[iter]; }
+
+        linkIterator &operator++() { iter = next[iter]; return *this; }
+        linkIterator &operator--() { iter = prev[iter]; return *this; }
+        linkIterator  operator++(int) { linkIterator old = *this; ++*this; return old; }
+        linkIterator  operator--(int) { linkIterator old = *this; --*this; return old; }
+
+        bool operator==(const linkIterator &other) const { return iter == other.iter; }
+        bool operator!=(const linkIterator &other) const { return iter != other.iter; }
+
+        /// @brief Index of node to use with index based methods
+        Index index() const { return iter; }
+
+    private:
+        template <bool otherConst> friend class linkIterator;
+
+        const Index *next;
+        const Index *prev;
+        pointer      data;
+        Index        iter;
+    };
+
+    typedef linkIterator<false> iterator;
+    typedef linkIterator<true>  const_iterator;
+
+    /// @brief Empty list, storage is allocated by first insertion or reserve
+    cList() noexcept:
+        nextLinks(NULL), prevLinks(NULL), data(NULL),
+        elemCount(0), reserved(0), freeHead(NULL_LIST_IT), untouched(1),
+        growth(LIST_DEFAULT_GROWTH) {}
+
+    /// @brief Copy elements of other in their logical order, copy is linearized
+    cList(const cList &other): cList() {
+        growth = other.growth;
+        if (reserve(other.elemCount) != LIST_SUCCESS)
+            return;
+        for (Index iter = other.front(); iter != NULL_LIST_IT; iter = other.next(iter))
+            emplaceBack(other.data[iter]);
+    }
+
+    cList(cList &&other) noexcept: cList() {
+        swap(other);
+    }
+
+    cList &operator=(cList other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~cList() {
+        destroyElements();
+        ::free(nextLinks);
+        ::free(prevLinks);
+        ::free(data);
+    }
+
+    void swap(cList &other) noexcept {
+        std::swap(nextLinks, other.nextLinks);
+        std::swap(prevLinks, other.prevLinks);
+        std::swap(data,      other.data);
+        std::swap(elemCount, other.elemCount);
+        std::swap(reserved,  other.reserved);
+        std::swap(freeHead,  other.freeHead);
+        std::swap(untouched, other.untouched);
+        std::swap(growth,    other.growth);
+    }
+
+    Index size()     const { return elemCount; }
+    Index capacity() const { return reserved; }
+    bool  empty()    const { return elemCount == 0; }
+
+    /// @brief Return head of list, NULL_LIST_IT if list is empty
+    Index front() const { return elemCount ? nextLinks[0] : NULL_LIST_IT; }
+
+    /// @brief Return tale of list, NULL_LIST_IT if list is empty
+    Index back()  const { return elemCount ? prevLinks[0] : NULL_LIST_IT; }
+
+    /// @brief Return next element, no checks are made
+    Index next(Index iter) const { return nextLinks[iter]; }
+
+    /// @brief Return previous element, no checks are made
+    Index prev(Index iter) const { return prevLinks[iter]; }
+
+    iterator begin() { return iterator(nextLinks, prevLinks, data, front()); }
+    iterator end()   { return iterator(nextLinks, prevLinks, data, NULL_LIST_IT); }
+
+    const_iterator begin() const { return const_iterator(nextLinks, prevLinks, data, front()); }
+    const_iterator end()   const { return const_iterator(nextLinks, prevLinks, data, NULL_LIST_IT); }
+
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend()   const { return end(); }
+
+    /// @brief STL iterator pointing to node, no checks are made
+    iterator       iteratorOf(Index iter)       { return iterator(nextLinks, prevLinks, data, iter); }
+    const_iterator iteratorOf(Index iter) const { return const_iterator(nextLinks, prevLinks, data, iter); }
+
+    /// @brief Value of element, no checks are made
+    T       &operator[](Index iter)       { return data[iter]; }
+    const T &operator[](Index iter) const { return data[iter]; }
+
+    /// @brief Get value from given list node
+    /// @return Pointer to value, NULL if iter doesn't point to element
+    T *get(Index iter) {
+        if (iter <= NULL_LIST_IT || iter > reserved || slotIsFree(iter))
+            return NULL;
+        return &data[iter];
+    }
+
+    const T *get(Index iter) const {
+        return const_cast<cList *>(this)->get(iter);
+    }
+
+    /// @brief Construct element in place after iterator
+    /// @return Iterator to inserted elem, INVALID_LIST_IT on error
+    template <typename... Args>
+    Index emplaceAfter(Index iter, Args &&... args) {
+        if (iter < 0 || iter > reserved || (iter != NULL_LIST_IT && slotIsFree(iter))) {
+            logPrint(L_DEBUG, 0, "Invalid iterator passed in cList<T>::emplaceAfter: %lld\n"
+                                 "For list[%p] maximum iterator is %lld\n", (long long) iter, this, (long long) reserved);
+            return INVALID_LIST_IT;
+        }
+        if (elemCount == reserved) {
+            // args may refer to element of this list, so value is built before storage moves
+            T elem(std::forward<Args>(args)...);
+            if (grow((int64_t) reserved + 1) != LIST_SUCCESS)
+                return INVALID_LIST_IT;
+            return linkNewAfter(iter, std::move(elem));
+        }
+        return linkNewAfter(iter, std::forward<Args>(args)...);
+    }
+
+    /// @brief Construct element in place before iterator
+    template <typename... Args>
+    Index emplaceBefore(Index iter, Args &&... args) {
+        if (iter < 0 || iter > reserved || (iter != NULL_LIST_IT && slotIsFree(iter))) {
+            logPrint(L_DEBUG, 0, "Invalid iterator passed in cList<T>::emplaceBefore: %lld\n"
+                                 "For list[%p] maximum iterator is %lld\n", (long long) iter, this, (long long) reserved);
+            return INVALID_LIST_IT;
+        }
+        return emplaceAfter(nextLinks ? prevLinks[iter] : NULL_LIST_IT, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    Index emplaceBack(Args &&... args) {
+        return emplaceAfter(back(), std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    Index emplaceFront(Args &&... args) {
+        return emplaceAfter(NULL_LIST_IT, std::forward<Args>(args)...);
+    }
+
+    Index insertAfter (Index iter, const T &elem) { return emplaceAfter (iter, elem); }
+    Index insertAfter (Index iter, T &&elem)      { return emplaceAfter (iter, std::move(elem)); }
+    Index insertBefore(Index iter, const T &elem) { return emplaceBefore(iter, elem); }
+    Index insertBefore(Index iter, T &&elem)      { return emplaceBefore(iter, std::move(elem)); }
+
+    Index pushBack (const T &elem) { return emplaceBack (elem); }
+    Index pushBack (T &&elem)      { return emplaceBack (std::move(elem)); }
+    Index pushFront(const T &elem) { return emplaceFront(elem); }
+    Index pushFront(T &&elem)      { return emplaceFront(std::move(elem)); }
+
+    /// @brief Remove element by given iterator
+    enum listStatus remove(Index iter) {
+        if (iter <= NULL_LIST_IT || iter > reserved || slotIsFree(iter)) {
+            logPrint(L_DEBUG, 0, "Attempt to remove slot %lld which isn't element of list[%p]\n", (long long) iter, this);
+            return LIST_ERROR;
+        }
+
+        data[iter].~T();
+        Index nextElem = nextLinks[iter],
+              prevElem = prevLinks[iter];
+        nextLinks[prevElem] = nextElem;
+        prevLinks[nextElem] = prevElem;
+
+        prevLinks[iter] = INVALID_LIST_IT;
+        nextLinks[iter] = freeHead;
+        freeHead = iter;
+        elemCount--;
+
+        if (checkFailed(__PRETTY_FUNCTION__))
+            return LIST_ERROR;
+        return LIST_SUCCESS;
+    }
+
+    /// @brief Pop head element
+    enum listStatus popFront() { return remove(front()); }
+
+    /// @brief Pop tale element
+    enum listStatus popBack()  { return remove(back()); }
+
+    /// @brief Remove all elements from list
+    /// O(1) for trivially destructible T, storage is kept
+    void clear() {
+        destroyElements();
+        if (nextLinks) {
+            nextLinks[0] = 0;
+            prevLinks[0] = 0;
+        }
+        elemCount = 0;
+        freeHead  = NULL_LIST_IT;
+        untouched = 1;
+    }
+
+    /// @brief Find first occurrence of elem in list
+    /// @return Iterator to found elem, INVALID_LIST_IT otherwise
+    Index find(const T &elem) const {
+        for (Index iter = front(); iter != NULL_LIST_IT; iter = nextLinks[iter])
+            if (data[iter] == elem)
+                return iter;
+        return INVALID_LIST_IT;
+    }
+
+    /*! @brief Stable O(n log n) merge sort by relinking, payloads aren't moved
+        Same algorithm as listSort, but comparator is inlined
+        @param less Strict weak ordering, less(a, b) is true if a goes before b
+    !*/
+    template <typename Compare = std::less<T> >
+    enum listStatus sort(Compare less = Compare()) {
+        if (elemCount < 2)
+            return LIST_SUCCESS;
+
+        for (int64_t width = 1; ; width *= 2) {
+            Index left = nextLinks[0],
+                  tale = 0;
+            int32_t merges = 0;
+
+            while (left != NULL_LIST_IT) {
+                merges++;
+                Index right = left;
+                int64_t leftSize = 0, rightSize = width;
+                for (; leftSize < width && right != NULL_LIST_IT; leftSize++)
+                    right = nextLinks[right];
+
+                while (leftSize > 0 || (rightSize > 0 && right != NULL_LIST_IT)) {
+                    Index taken = NULL_LIST_IT;
+                    // taking from left run on equal elements keeps sort stable
+                    if (leftSize > 0 && (rightSize == 0 || right == NULL_LIST_IT || !less(data[right], data[left]))) {
+                        taken = left;
+                        left  = nextLinks[left];
+                        leftSize--;
+                    } else {
+                        taken = right;
+                        right = nextLinks[right];
+                        rightSize--;
+                    }
+                    nextLinks[tale] = taken;
+                    tale = taken;
+                }
+                left = right;
+            }
+            nextLinks[tale] = NULL_LIST_IT;
+
+            if (merges <= 1)
+                break;
+        }
+
+        Index prevElem = NULL_LIST_IT;
+        for (Index iter = nextLinks[0]; iter != NULL_LIST_IT; iter = nextLinks[iter]) {
+            prevLinks[iter] = prevElem;
+            prevElem = iter;
+        }
+        prevLinks[0] = prevElem;
+
+        if (checkFailed(__PRETTY_FUNCTION__))
+            return LIST_ERROR;
+        return LIST_SUCCESS;
+    }
+
+    /// @brief Make sure list can store newReserved elements without reallocation
+    enum listStatus reserve(Index newReserved) {
+        if (newReserved < 0) {
+            logPrint(L_ZERO, 1, "Negative capacity %lld requested for list [%p]\n", (long long) newReserved, this);
+            return LIST_SIZE_ERROR;
+        }
+        if (newReserved > maxReserved) {
+            logPrint(L_ZERO, 1, "List [%p] can't reserve %lld elements, maximum capacity is %lld\n",
+                                this, (long long) newReserved, (long long) maxReserved);
+            return LIST_SIZE_ERROR;
+        }
+        if (newReserved <= reserved)
+            return LIST_SUCCESS;
+        return resize(newReserved);
+    }
+
+    /// @brief Set how list grows when it runs out of free slots
+    enum listStatus setGrowthPolicy(listGrowthPolicy_t policy) {
+        if (!(policy.factor >= 1) || policy.step < 0 || policy.maxStep < 0) {
+            logPrint(L_ZERO, 1, "Bad growth policy of list [%p]: factor = %g, step = %d, maxStep = %d\n",
+                                this, policy.factor, policy.step, policy.maxStep);
+            return LIST_ERROR;
+        }
+        growth = policy;
+        return LIST_SUCCESS;
+    }
+
+    /// @brief Check if slot doesn't contain element, iter must be in [1, reserved]
+    bool slotIsFree(Index iter) const {
+        return iter >= untouched || prevLinks[iter] == INVALID_LIST_IT;
+    }
+
+    /*! @brief Check list on logic errors
+        Prints some info about error
+        @return Corresponding error code
+    !*/
+    enum listStatus verify() const {
+        if (elemCount < 0 || reserved < 0 || elemCount > reserved) {
+            logPrint(L_ZERO, 1, "Bad size of list [%p]: size = %lld, reserved = %lld\n",
+                                this, (long long) elemCount, (long long) reserved);
+            return LIST_SIZE_ERROR;
+        }
+        if (!nextLinks) {
+            if (reserved == 0 && elemCount == 0)
+                return LIST_SUCCESS;
+            logPrint(L_ZERO, 1, "Storage isn't allocated in list [%p]\n", this);
+            return LIST_MEMORY_ERROR;
+        }
+        if (!prevLinks || !data) {
+            logPrint(L_ZERO, 1, "Prev or data isn't allocated in list [%p]\n", this);
+            return LIST_MEMORY_ERROR;
+        }
+        if (untouched < 1 || untouched > reserved + 1) {
+            logPrint(L_ZERO, 1, "Bad untouched region of list [%p]: [%lld, %lld]\n",
+                                this, (long long) untouched, (long long) reserved);
+            return LIST_SIZE_ERROR;
+        }
+
+        Index visited = 0;
+        for (Index iter = nextLinks[0]; iter != NULL_LIST_IT; iter = nextLinks[iter], visited++) {
+            if (visited >= elemCount || iter < 0 || iter >= untouched) {
+                logPrint(L_ZERO, 1, "Wrong linking in list [%p] in next array: node %lld\n", this, (long long) iter);
+                return LIST_NEXT_LINK_ERROR;
+            }
+            if (nextLinks[iter] < 0 || nextLinks[iter] >= untouched || prevLinks[nextLinks[iter]] != iter) {
+                logPrint(L_ZERO, 1, "prev[next[%lld]] != %lld in list [%p]\n", (long long) iter, (long long) iter, this);
+                return LIST_PREV_LINK_ERROR;
+            }
+        }
+        if (visited != elemCount) {
+            logPrint(L_ZERO, 1, "Wrong linking in list [%p] in next array\n", this);
+            return LIST_NEXT_LINK_ERROR;
+        }
+        if (prevLinks[nextLinks[0]] != 0 || nextLinks[prevLinks[0]] != 0) {
+            logPrint(L_ZERO, 1, "Bad head or tale of list [%p]\n", this);
+            return LIST_HEAD_ERROR;
+        }
+
+        for (Index iter = freeHead; iter != NULL_LIST_IT; iter = nextLinks[iter], visited++) {
+            if (visited >= reserved || iter < 0 || iter >= untouched || prevLinks[iter] != INVALID_LIST_IT) {
+                logPrint(L_ZERO, 1, "Wrong linking in list [%p] in free sequence: node %lld\n", this, (long long) iter);
+                return LIST_FREE_LINK_ERROR;
+            }
+        }
+        // elements and free sequence together cover everything before untouched region
+        if (visited != untouched - 1) {
+            logPrint(L_ZERO, 1, "Wrong linking in list [%p] in free sequence\n", this);
+            return LIST_FREE_LINK_ERROR;
+        }
+        return LIST_SUCCESS;
+    }
+
+    /*! @brief Print header and links of touched slots to log, works only with L_DEBUG log level
+        Text counterpart of listDump, payloads aren't printed because T may have no printer
+    !*/
+    void dump(const char *callMessage) const {
+        if (getLogLevel() < L_DEBUG)
+            return;
+
+        logPrintColor(L_ZERO, "#FF0000", "#CCCCCC", "<h2>-------cList<T> [%p] dump--------</h2>\n", this);
+        logPrint(L_ZERO, 0, "<h2><b>Called with message: %s</b></h2>\n", callMessage);
+        logPrint(L_ZERO, 0, "%zu-byte links, %zu-byte elements\n"
+                            "size = %lld, reserved = %lld, free = %lld, untouched = %lld\n",
+                            sizeof(Index), sizeof(T), (long long) elemCount, (long long) reserved,
+                            (long long) freeHead, (long long) untouched);
+        if (!nextLinks)
+            return;
+
+        logPrint(L_ZERO, 0, "<pre>%8s %8s %8s\n", "slot", "next", "prev");
+        for (Index slot = 0; slot < untouched && slot <= reserved; slot++)
+            logPrint(L_ZERO, 0, "%8lld %8lld %8lld%s\n", (long long) slot, (long long) nextLinks[slot],
+                                (long long) prevLinks[slot], (prevLinks[slot] == INVALID_LIST_IT) ? " free" : "");
+        logPrint(L_ZERO, 0, "</pre>\n<hr>\n");
+    }
+
+private:
+    /// @brief Construct element in free slot and link it after iter, list must have free slot
+    /// Slot is taken only after construction, so throwing constructor leaves list unchanged
+    template <typename... Args>
+    Index linkNewAfter(Index iter, Args &&... args) {
+        // free sequence first, then untouched region
+        Index newElem = (freeHead != NULL_LIST_IT) ? freeHead : untouched;
+        new (&data[newElem]) T(std::forward<Args>(args)...);
+        if (newElem == freeHead)
+            freeHead = nextLinks[newElem];
+        else
+            untouched++;
+
+        prevLinks[newElem] = iter;
+        nextLinks[newElem] = nextLinks[iter];
+        prevLinks[nextLinks[iter]] = newElem;
+        nextLinks[iter] = newElem;
+        elemCount++;
+
+        if (checkFailed(__PRETTY_FUNCTION__))
+            return INVALID_LIST_IT;
+        return newElem;
+    }
+
+    void destroyElements() {
+        if constexpr (!std::is_trivially_destructible<T>::value)
+            for (Index iter = front(); iter != NULL_LIST_IT; iter = nextLinks[iter])
+                data[iter].~T();
+    }
+
+    /// @brief Grow storage according to growth policy, but at least to minReserved elements
+    enum listStatus grow(int64_t minReserved) {
+        // first allocation takes MIN_LIST_RESERVED at once, maxReserved of any Index is bigger
+        int64_t newReserved = listNextCapacity(&growth, reserved, minReserved, maxReserved);
+        if (newReserved < (int64_t) MIN_LIST_RESERVED)
+            newReserved = MIN_LIST_RESERVED;
+
+        if (newReserved < minReserved || newReserved <= reserved) {
+            logPrint(L_ZERO, 1, "List [%p] can't grow to %lld elements, maximum capacity is %lld\n",
+                                this, (long long) minReserved, (long long) maxReserved);
+            return LIST_SIZE_ERROR;
+        }
+        return resize((Index) newReserved);
+    }
+
+    /// @brief Grow storage to newReserved elements, new slots join untouched region without initialization
+    enum listStatus resize(Index newReserved) {
+        logPrint(L_DEBUG, 0, "Reallocating list [%p]: %lld -> %lld\n", this, (long long) reserved, (long long) newReserved);
+
+        // + 1 because NULL list element isn't counted
+        size_t newCapacity = (size_t) newReserved + 1;
+        bool   firstAlloc  = (nextLinks == NULL);
+
+        Index *newNext = (Index *) realloc(nextLinks, newCapacity * sizeof(Index));
+        if (!newNext)
+            return allocFailed();
+        nextLinks = newNext;
+
+        Index *newPrev = (Index *) realloc(prevLinks, newCapacity * sizeof(Index));
+        if (!newPrev)
+            return allocFailed();
+        prevLinks = newPrev;
+
+        T *newData = NULL;
+        if constexpr (relocatable) {
+            newData = (T *) realloc((void *) data, newCapacity * sizeof(T));
+            if (!newData)
+                return allocFailed();
+        } else {
+            newData = (T *) malloc(newCapacity * sizeof(T));
+            if (!newData)
+                return allocFailed();
+            for (Index iter = front(); iter != NULL_LIST_IT; iter = nextLinks[iter]) {
+                new (&newData[iter]) T(std::move(data[iter]));
+                data[iter].~T();
+            }
+            ::free(data);
+        }
+        data = newData;
+
+        if (firstAlloc) {
+            nextLinks[0] = 0;
+            prevLinks[0] = 0;
+        }
+        // untouched region always ends at reserved, so new slots simply extend it
+        reserved = newReserved;
+        return LIST_SUCCESS;
+    }
+
+    enum listStatus allocFailed() {
+        // arrays that were already grown stay bigger, list itself isn't changed
+        logPrint(L_ZERO, 1, "Reallocation of cList<T>[%p] storage failed\n", this);
+        return LIST_MEMORY_ERROR;
+    }
+
+    /// @brief Verify list after modification if verification is on
+    bool checkFailed(const char *function) const {
+#if defined(LIST_VERIFICATION) && !defined(NDEBUG)
+        enum listStatus status = verify();
+        if (status != LIST_SUCCESS) {
+            logPrint(L_ZERO, 1, "<h2>%s\n", function);
+            logPrint(L_ZERO, 1, "List[%p] error occurred. Error code = %d</h2>\n", this, status);
+            dump(function);
+            return true;
+        }
+#else
+        (void) function;
+#endif
+        return false;
+    }
+
+    Index *nextLinks;
+    Index *prevLinks;
+    T     *data;          ///< data[0] belongs to NULL element and is never constructed
+
+    Index  elemCount;
+    Index  reserved;
+    Index  freeHead;
+    Index  untouched;     ///< Slots [untouched, reserved] are free, but not initialized and not linked in free
+
+    listGrowthPolicy_t growth;
+};
+
+} // namespace clist
+
+#endif
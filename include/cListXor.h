@@ -0,0 +1,139 @@
+#ifndef C_LIST_XOR_H
+#define C_LIST_XOR_H
+
+/*------------------XOR-LINKED COMPACT LIST-----------------------------------*/
+// listXor_t keeps one link per slot: link = next ^ prev, so links take half
+// of next + prev arrays of cList_t. Slot 0 is NULL element as in cList_t,
+// link[0] = first ^ last and first is kept in header, so list is a ring
+// through slot 0 and can be entered from both sides.
+// Neighbours of slot can't be found from slot alone, so elements are reached
+// by listXorCursor_t holding two adjacent slots: prev and cur. Cursor at
+// slot 0 is past the end (prev = last) or before the start (it is the same ring).
+// Free slots keep ~next of free sequence in link, so they have negative link,
+// while link of element is xor of two slots and is never negative.
+// Insertion or removal invalidates cursors whose prev or cur is adjacent to
+// changed place, the cursor passed to the call is updated.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cList.h"
+
+typedef struct listXor {
+    size_t   elemSize;
+    int32_t *link;          ///< next ^ prev of elements, ~next free slot of free ones
+    void    *data;
+    listPrintFunction_t sPrint;
+
+    listIterator_t first;   ///< NULL_LIST_IT if list is empty
+    int32_t  size;
+    int32_t  reserved;      ///< Slots [1, reserved] belong to list
+    listIterator_t free;
+    int32_t  untouched;     ///< Slots [untouched, reserved] are free, but not initialized and not linked in free
+
+    listGrowthPolicy_t growth;
+
+    enum listVerifyLevel verifyLevel;
+    uint32_t verifyPeriod;  ///< Checks between full verifications in LIST_VERIFY_SAMPLED
+    uint32_t verifyCounter;
+} listXor_t;
+
+/// @brief Two adjacent slots of list, prev is logically before cur
+typedef struct listXorCursor {
+    listIterator_t prev;
+    listIterator_t cur;     ///< NULL_LIST_IT if cursor is past the end
+} listXorCursor_t;
+
+/// @brief Payload of slot, no checks are made
+inline void *listXorDataOf(const listXor_t *list, listIterator_t iter) {
+    return (char *) list->data + list->elemSize * (size_t) iter;
+}
+
+/// @brief Move cursor to next element and return it, no checks are made
+inline listIterator_t listXorNextOf(const listXor_t *list, listXorCursor_t *cursor) {
+    listIterator_t nextSlot = list->link[cursor->cur] ^ cursor->prev;
+    cursor->prev = cursor->cur;
+    cursor->cur  = nextSlot;
+    return nextSlot;
+}
+
+/// @brief Construct empty list with elements of elemSize, sPrint is used by dump only
+enum listStatus listXorCtor(listXor_t *list, size_t elemSize, listPrintFunction_t sPrint);
+
+/// @brief Destruct list, all cursors become invalid
+enum listStatus listXorDtor(listXor_t *list);
+
+/// @brief Make sure list has reserved slots without reallocation
+enum listStatus listXorReserve(listXor_t *list, int32_t reserved);
+
+/// @brief Set how list grows when it runs out of free slots
+enum listStatus listXorSetGrowthPolicy(listXor_t *list, listGrowthPolicy_t policy);
+
+/// @brief Remove all elements, keeps capacity
+enum listStatus listXorClear(listXor_t *list);
+
+/// @brief Check header, walk list and free sequence, O(untouched)
+enum listStatus listXorVerify(listXor_t *list);
+
+/// @brief Check list according to its verification level, local checks look at slots around cursor
+enum listStatus listXorCheck(listXor_t *list, listXorCursor_t cursor);
+
+/// @brief Set verification level of list, period is used only by LIST_VERIFY_SAMPLED
+enum listStatus listXorSetVerifyLevel(listXor_t *list, enum listVerifyLevel level, uint32_t period);
+
+/// @brief Graphical dump, links are decoded by walk from first element
+/// NOTE: log must be opened in L_HTML_MODE
+enum listStatus listXorDump(listXor_t *list, const char *callMessage);
+
+#define LIST_XOR_DUMP(list, msg)                                                    \
+        do {                                                                        \
+            logPrintWithTime(L_ZERO, 0, "<b>listXor_t dump</b>\n"                   \
+                                "Called from %s:%d\n", __FILE__, __LINE__);         \
+            listXorDump(list, msg);                                                 \
+        } while(0)
+
+/// @brief Cursor at first element, it is past the end if list is empty
+listXorCursor_t listXorBegin(listXor_t *list);
+
+/// @brief Cursor past the end, listXorPrev moves it to last element
+listXorCursor_t listXorEnd(listXor_t *list);
+
+/// @brief Cursor at last element, it is past the end if list is empty
+listXorCursor_t listXorLast(listXor_t *list);
+
+/// @brief Move cursor to next element, past the end wraps to first element
+/// @return New cur of cursor, INVALID_LIST_IT if cursor doesn't hold adjacent slots
+listIterator_t listXorNext(listXor_t *list, listXorCursor_t *cursor);
+
+/// @brief Move cursor to previous element, first element moves to past the end
+/// @return New cur of cursor, INVALID_LIST_IT if cursor doesn't hold adjacent slots
+listIterator_t listXorPrev(listXor_t *list, listXorCursor_t *cursor);
+
+/// @brief Get value of element under cursor
+/// @return Pointer to value, NULL if cursor is past the end or invalid
+void *listXorGet(listXor_t *list, listXorCursor_t cursor);
+
+/*! @brief Insert elem before cur of cursor, past the end cursor appends elem
+    Cursor is moved to inserted element, its prev stays the same
+    @return Slot of inserted elem, INVALID_LIST_IT on error
+!*/
+listIterator_t listXorInsert(listXor_t *list, listXorCursor_t *cursor, const void *elem);
+
+/*! @brief Remove element under cursor, copy its value to elem if elem isn't NULL
+    Cursor is moved to next element, its prev stays the same
+!*/
+enum listStatus listXorRemove(listXor_t *list, listXorCursor_t *cursor, void *elem);
+
+/// @brief Push elem after last element
+listIterator_t listXorPushBack(listXor_t *list, const void *elem);
+
+/// @brief Push elem before first element
+listIterator_t listXorPushFront(listXor_t *list, const void *elem);
+
+/// @brief Remove last element, copy its value to elem if elem isn't NULL
+enum listStatus listXorPopBack(listXor_t *list, void *elem);
+
+/// @brief Remove first element, copy its value to elem if elem isn't NULL
+enum listStatus listXorPopFront(listXor_t *list, void *elem);
+
+#endif
@@ -0,0 +1,1437 @@
+/// @file
+/// @brief Benchmark of cList_t and clist::cList<T> against std::list and std::vector
+/// Build and run with `make bench`
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "error_debug.h"
+#include "logger.h"
+#include "argvProcessor.h"
+#include "cList.h"
+#include "cListT.h"
+#include "cListPool.h"
+#include "cListQueue.h"
+#include "cListShared.h"
+#include "cListParallel.h"
+#include "cListXor.h"
+
+/*------------------ALLOCATION COUNTING---------------------------------------*/
+// bench.out is linked with -Wl,--wrap=malloc,... so every allocation made by
+// cList and by std containers (through operator new below) goes through here
+
+// threaded workloads allocate from several threads, only the total matters
+static std::atomic<size_t> allocCounter(0);
+
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+    allocCounter.fetch_add(1, std::memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+    allocCounter.fetch_add(1, std::memory_order_relaxed);
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    allocCounter.fetch_add(1, std::memory_order_relaxed);
+    return __real_realloc(ptr, size);
+}
+}
+
+// delete below frees memory of operator new with free, GCC reports it as mismatched,
+// but replaced operator new allocates it with malloc
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void *operator new(size_t size) {
+    void *ptr = malloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t size) {
+    void *ptr = malloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept              { free(ptr); }
+void operator delete[](void *ptr) noexcept            { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept      { free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept    { free(ptr); }
+
+#pragma GCC diagnostic pop
+
+/*------------------PEAK RSS--------------------------------------------------*/
+
+/// @brief Reset peak resident set size of process (Linux only, silently ignored otherwise)
+static void resetPeakRss() {
+    FILE *clearRefs = fopen("/proc/self/clear_refs", "w");
+    if (!clearRefs) return;
+    fputs("5", clearRefs);
+    fclose(clearRefs);
+}
+
+/// @brief Peak resident set size since last resetPeakRss() in KiB, 0 if unknown
+static long readPeakRss() {
+    FILE *status = fopen("/proc/self/status", "r");
+    if (!status) return 0;
+
+    char line[128] = "";
+    long peak = 0;
+    while (fgets(line, sizeof(line), status))
+        if (sscanf(line, "VmHWM: %ld", &peak) == 1)
+            break;
+
+    fclose(status);
+    return peak;
+}
+
+/*------------------CONTAINER ADAPTERS----------------------------------------*/
+// Every adapter keeps handles of live elements, so random insert/remove picks
+// uniformly distributed elements. Handles of std::vector are positions
+
+typedef std::mt19937_64 benchRng_t;
+
+/// @tparam indexed Enable hash index, makes find O(1) at cost of index updates
+template <enum listLayout layout, bool indexed = false>
+class cListBench {
+public:
+    static const char *name() {
+        if (indexed)
+            return "cList_t idx";
+        return (layout == LIST_LAYOUT_AOS) ? "cList_t AoS" : "cList_t SoA";
+    }
+    static const bool shiftsOnInsert = false;
+
+    cListBench(): list(), handles() {
+        listCtor(&list, sizeof(double), doublePrint, layout);
+        if (indexed)
+            listEnableIndex(&list);
+    }
+    ~cListBench() { listDtor(&list); }
+
+    cListBench(const cListBench &) = delete;
+    cListBench &operator=(const cListBench &) = delete;
+
+    void reserveHandles(size_t count) { handles.reserve(count); }
+
+    void pushBack(double value)  { handles.push_back(listPushBack(&list, &value)); }
+    void pushBackBulk(const double *values, size_t count) { listPushBackBulk(&list, values, count); }
+    void pushFront(double value) { handles.push_back(listPushFront(&list, &value)); }
+
+    void insertRandom(benchRng_t &rng, double value) {
+        listIterator_t iter = handles[rng() % handles.size()];
+        handles.push_back(listInsertAfter(&list, iter, &value));
+    }
+
+    void removeRandom(benchRng_t &rng) {
+        size_t idx = rng() % handles.size();
+        listRemove(&list, handles[idx]);
+        handles[idx] = handles.back();
+        handles.pop_back();
+    }
+
+    bool find(double value) { return listFind(&list, &value) != INVALID_LIST_IT; }
+    bool findAny(double value) { return listFindAny(&list, &value) != INVALID_LIST_IT; }
+
+    void sort() { listSort(&list, doubleCompare); }
+
+    cList_t *raw() { return &list; }
+
+    double traverse() {
+        double sum = 0;
+        for (listCursor_t cursor = listCursorBegin(&list); listCursorValid(&cursor); listCursorNext(&cursor))
+            sum += *(double *) listCursorGet(&cursor);
+        return sum;
+    }
+
+private:
+    static int doublePrint(char *buffer, const void *a) {
+        return sprintf(buffer, "%.3g", *(const double *)a);
+    }
+
+    static int doubleCompare(const void *a, const void *b) {
+        double lhs = *(const double *) a, rhs = *(const double *) b;
+        return (lhs > rhs) - (lhs < rhs);
+    }
+
+    cList_t list;
+    std::vector<listIterator_t> handles;
+};
+
+class cListTBench {
+public:
+    static const char *name() { return "cList<T>"; }
+    static const bool shiftsOnInsert = false;
+
+    cListTBench(): list(), handles() {}
+
+    void reserveHandles(size_t count) { handles.reserve(count); }
+
+    void pushBack(double value)  { handles.push_back(list.pushBack(value)); }
+    void pushBackBulk(const double *values, size_t count) {
+        for (size_t idx = 0; idx < count; idx++)
+            list.pushBack(values[idx]);
+    }
+    void pushFront(double value) { handles.push_back(list.pushFront(value)); }
+
+    void insertRandom(benchRng_t &rng, double value) {
+        listIterator_t iter = handles[rng() % handles.size()];
+        handles.push_back(list.insertAfter(iter, value));
+    }
+
+    void removeRandom(benchRng_t &rng) {
+        size_t idx = rng() % handles.size();
+        list.remove(handles[idx]);
+        handles[idx] = handles.back();
+        handles.pop_back();
+    }
+
+    bool find(double value) { return list.find(value) != INVALID_LIST_IT; }
+    bool findAny(double value) { return find(value); }
+
+    void sort() { list.sort(); }
+
+    double traverse() {
+        double sum = 0;
+        for (double elem : list)
+            sum += elem;
+        return sum;
+    }
+
+private:
+    clist::cList<double> list;
+    std::vector<listIterator_t> handles;
+};
+
+class stdListBench {
+public:
+    static const char *name() { return "std::list"; }
+    static const bool shiftsOnInsert = false;
+
+    stdListBench(): list(), handles() {}
+
+    void reserveHandles(size_t count) { handles.reserve(count); }
+
+    void pushBack(double value) {
+        list.push_back(value);
+        handles.push_back(std::prev(list.end()));
+    }
+    void pushBackBulk(const double *values, size_t count) { list.insert(list.end(), values, values + count); }
+    void pushFront(double value) {
+        list.push_front(value);
+        handles.push_back(list.begin());
+    }
+
+    void insertRandom(benchRng_t &rng, double value) {
+        std::list<double>::iterator iter = handles[rng() % handles.size()];
+        handles.push_back(list.insert(std::next(iter), value));
+    }
+
+    void removeRandom(benchRng_t &rng) {
+        size_t idx = rng() % handles.size();
+        list.erase(handles[idx]);
+        handles[idx] = handles.back();
+        handles.pop_back();
+    }
+
+    bool find(double value) {
+        for (double elem : list)
+            if (elem == value) return true;
+        return false;
+    }
+    bool findAny(double value) { return find(value); }
+
+    void sort() { list.sort(); }
+
+    double traverse() {
+        double sum = 0;
+        for (double elem : list)
+            sum += elem;
+        return sum;
+    }
+
+private:
+    std::list<double> list;
+    std::vector<std::list<double>::iterator> handles;
+};
+
+class stdVectorBench {
+public:
+    static const char *name() { return "std::vector"; }
+    /// front and middle insert/erase shift O(n) elements
+    static const bool shiftsOnInsert = true;
+
+    stdVectorBench(): vec() {}
+
+    void reserveHandles(size_t) {}
+
+    void pushBack(double value)  { vec.push_back(value); }
+    void pushBackBulk(const double *values, size_t count) { vec.insert(vec.end(), values, values + count); }
+    void pushFront(double value) { vec.insert(vec.begin(), value); }
+
+    void insertRandom(benchRng_t &rng, double value) {
+        size_t pos = rng() % vec.size();
+        vec.insert(vec.begin() + (ptrdiff_t) pos + 1, value);
+    }
+
+    void removeRandom(benchRng_t &rng) {
+        size_t pos = rng() % vec.size();
+        vec.erase(vec.begin() + (ptrdiff_t) pos);
+    }
+
+    bool find(double value) {
+        for (double elem : vec)
+            if (elem == value) return true;
+        return false;
+    }
+    bool findAny(double value) { return find(value); }
+
+    void sort() { std::sort(vec.begin(), vec.end()); }
+
+    double traverse() {
+        double sum = 0;
+        for (double elem : vec)
+            sum += elem;
+        return sum;
+    }
+
+private:
+    std::vector<double> vec;
+};
+
+/*------------------MANY SMALL LISTS------------------------------------------*/
+// Every adapter holds listCount lists of SMALL_LIST_SIZE elements, it is
+// constructed, filled, traversed and destructed in timed section
+
+/// Elements in every list of smallLists workload
+const size_t SMALL_LIST_SIZE = 4;
+/// Upper bound on number of lists, separate cList_t per list is too heavy beyond it
+const size_t SMALL_LISTS_MAX = 1000000;
+
+class cListManyBench {
+public:
+    static const char *name() { return "cList_t"; }
+
+    explicit cListManyBench(size_t listCount): lists(listCount) {
+        for (cList_t &list : lists)
+            listCtor(&list, sizeof(double), NULL, LIST_LAYOUT_SOA);
+    }
+    ~cListManyBench() {
+        for (cList_t &list : lists)
+            listDtor(&list);
+    }
+
+    cListManyBench(const cListManyBench &) = delete;
+    cListManyBench &operator=(const cListManyBench &) = delete;
+
+    void pushBack(size_t listIdx, double value) { listPushBack(&lists[listIdx], &value); }
+
+    double traverse() {
+        double sum = 0;
+        for (cList_t &list : lists)
+            for (listCursor_t cursor = listCursorBegin(&list); listCursorValid(&cursor); listCursorNext(&cursor))
+                sum += *(double *) listCursorGet(&cursor);
+        return sum;
+    }
+
+private:
+    std::vector<cList_t> lists;
+};
+
+class poolListManyBench {
+public:
+    static const char *name() { return "poolList_t"; }
+
+    explicit poolListManyBench(size_t listCount): pool(), lists(listCount) {
+        listPoolCtor(&pool, sizeof(double));
+        for (poolList_t &list : lists)
+            poolListCtor(&list, &pool);
+    }
+    ~poolListManyBench() { listPoolDtor(&pool); }
+
+    poolListManyBench(const poolListManyBench &) = delete;
+    poolListManyBench &operator=(const poolListManyBench &) = delete;
+
+    void pushBack(size_t listIdx, double value) { poolListPushBack(&lists[listIdx], &value); }
+
+    double traverse() {
+        double sum = 0;
+        for (poolList_t &list : lists)
+            for (listIterator_t iter = list.first; iter != NULL_LIST_IT; iter = pool.next[iter])
+                sum += *(double *) poolDataOf(&pool, iter);
+        return sum;
+    }
+
+private:
+    listPool_t pool;
+    std::vector<poolList_t> lists;
+};
+
+class stdListManyBench {
+public:
+    static const char *name() { return "std::list"; }
+
+    explicit stdListManyBench(size_t listCount): lists(listCount) {}
+
+    void pushBack(size_t listIdx, double value) { lists[listIdx].push_back(value); }
+
+    double traverse() {
+        double sum = 0;
+        for (const std::list<double> &list : lists)
+            for (double elem : list)
+                sum += elem;
+        return sum;
+    }
+
+private:
+    std::vector<std::list<double> > lists;
+};
+
+/*------------------CONCURRENT FIFO-------------------------------------------*/
+// Producers push their share of items, one consumer pops all of them.
+// Full or empty queue is retried for a while if other side may run on another core,
+// then waited out with yield, so runs stay fair on few cores
+
+/// Capacity of bounded queues in queue workload
+const int32_t QUEUE_CAPACITY = 1 << 16;
+/// Largest number of producer threads, doubled from 1
+const size_t QUEUE_MAX_PRODUCERS = 8;
+/// Failed attempts before yield, yield costs a syscall while other side needs only a few ns
+const unsigned QUEUE_SPIN_ATTEMPTS = 64;
+
+/// @brief Wait after failed push or pop, attempt counts failures since last success
+static void queueWait(unsigned *attempt) {
+    static const bool otherCores = std::thread::hardware_concurrency() > 1;
+    if (otherCores && ++*attempt < QUEUE_SPIN_ATTEMPTS)
+        return;
+    *attempt = 0;
+    std::this_thread::yield();
+}
+
+class lockFreeQueueBench {
+public:
+    explicit lockFreeQueueBench(enum listQueueMode mode): queue() {
+        listQueueCtor(&queue, sizeof(double), QUEUE_CAPACITY, mode);
+    }
+    ~lockFreeQueueBench() { listQueueDtor(&queue); }
+
+    lockFreeQueueBench(const lockFreeQueueBench &) = delete;
+    lockFreeQueueBench &operator=(const lockFreeQueueBench &) = delete;
+
+    void push(double value) {
+        unsigned attempt = 0;
+        while (!listQueueTryPush(&queue, &value))
+            queueWait(&attempt);
+    }
+    bool tryPop(double *value) { return listQueueTryPop(&queue, value); }
+
+private:
+    listQueue_t queue;
+};
+
+/// cList_t behind global mutex, the way callers used it before lock-free queue
+class mutexListBench {
+public:
+    mutexListBench(): mutex(), list() {
+        listCtor(&list, sizeof(double), NULL, LIST_LAYOUT_SOA);
+    }
+    ~mutexListBench() { listDtor(&list); }
+
+    mutexListBench(const mutexListBench &) = delete;
+    mutexListBench &operator=(const mutexListBench &) = delete;
+
+    void push(double value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        listPushBack(&list, &value);
+    }
+    bool tryPop(double *value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.size == 0)
+            return false;
+        *value = *(double *) listDataOf(&list, listNextOf(&list, 0));
+        listPopFront(&list);
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    cList_t list;
+};
+
+/*------------------SHARED LIST-----------------------------------------------*/
+// Readers traverse list and check its sum while one writer moves elements and
+// periodically grows and shrinks storage, every update keeps sum unchanged
+
+/// Elements visited by all readers of one run
+const double SHARED_VISITS = 2e7;
+/// Largest number of reader threads, doubled from 1
+const size_t SHARED_MAX_READERS = 8;
+/// Pause of writer between updates, list is modified rarely
+const std::chrono::microseconds SHARED_WRITER_PAUSE(100);
+/// Every SHARED_GROWTH_PERIOD-th update reallocates storage
+const uint64_t SHARED_GROWTH_PERIOD = 16;
+
+typedef struct sharedUpdate {
+    benchRng_t *rng;
+    uint64_t    number;
+} sharedUpdate_t;
+
+/// @brief Move random element after another one, sometimes grow and shrink storage
+static enum listStatus sharedListUpdate(cList_t *list, void *ctx) {
+    sharedUpdate_t *update = (sharedUpdate_t *) ctx;
+    benchRng_t &rng = *update->rng;
+
+    listIterator_t moved = listAt(list, (int32_t) (rng() % (uint64_t) list->size));
+    double value = *(double *) listDataOf(list, moved);
+    listRemove(list, moved);
+    if (list->size > 0)
+        listInsertAfter(list, listAt(list, (int32_t) (rng() % (uint64_t) list->size)), &value);
+    else
+        listPushBack(list, &value);
+
+    if (++update->number % SHARED_GROWTH_PERIOD == 0) {
+        // zero sum batch forces reallocation and doesn't change sum
+        int32_t batch = list->reserved - list->size + 1;
+        double zero = 0;
+        listIterator_t first = NULL_LIST_IT;
+        for (int32_t idx = 0; idx < batch; idx++) {
+            listIterator_t pushed = listPushBack(list, &zero);
+            if (idx == 0) first = pushed;
+        }
+        listRemoveRange(list, first, listPrevOf(list, 0));
+        listShrinkToFit(list, NULL);
+    }
+    return LIST_SUCCESS;
+}
+
+static int sharedSumVisitor(const void *elem, listIterator_t, void *ctx) {
+    *(double *) ctx += *(const double *) elem;
+    return 0;
+}
+
+/// Visitor is read through volatile pointer, so neither traversal can inline it
+/// and both pay the same indirect call per element
+static listSharedVisitor_t volatile sharedSumCall = sharedSumVisitor;
+
+class rwlockListBench {
+public:
+    static const char *name() { return "rwlock"; }
+
+    rwlockListBench(): shared() {
+        listSharedCtor(&shared, sizeof(double), NULL, LIST_LAYOUT_SOA);
+    }
+    ~rwlockListBench() { listSharedDtor(&shared); }
+
+    rwlockListBench(const rwlockListBench &) = delete;
+    rwlockListBench &operator=(const rwlockListBench &) = delete;
+
+    void pushBack(double value) { listSharedPushBack(&shared, &value); }
+    void update(sharedUpdate_t *update) { listSharedUpdate(&shared, sharedListUpdate, update); }
+
+    double sum() {
+        double sum = 0;
+        listSharedForEach(&shared, sharedSumCall, &sum);
+        return sum;
+    }
+
+private:
+    listShared_t shared;
+};
+
+/// cList_t behind one mutex, readers exclude each other too
+class mutexReadListBench {
+public:
+    static const char *name() { return "mutex"; }
+
+    mutexReadListBench(): mutex(), list() {
+        listCtor(&list, sizeof(double), NULL, LIST_LAYOUT_SOA);
+    }
+    ~mutexReadListBench() { listDtor(&list); }
+
+    mutexReadListBench(const mutexReadListBench &) = delete;
+    mutexReadListBench &operator=(const mutexReadListBench &) = delete;
+
+    void pushBack(double value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        listPushBack(&list, &value);
+    }
+    void update(sharedUpdate_t *update) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sharedListUpdate(&list, update);
+    }
+
+    double sum() {
+        std::lock_guard<std::mutex> lock(mutex);
+        double sum = 0;
+        listSharedVisitor_t visitor = sharedSumCall;
+        for (listIterator_t iter = listNextOf(&list, 0); iter != NULL_LIST_IT; iter = listNextOf(&list, iter))
+            visitor(listDataOf(&list, iter), iter, &sum);
+        return sum;
+    }
+
+private:
+    std::mutex mutex;
+    cList_t list;
+};
+
+/*------------------WORKLOADS-------------------------------------------------*/
+
+/// Upper bound on elements touched by one workload, keeps O(n) per op runs finite
+const double WORK_BUDGET = 2e8;
+/// Upper bound on operations of random insert/remove/find workloads
+const size_t MAX_RANDOM_OPS = 100000;
+/// Number of elements pushed by one bulk operation
+const size_t BULK_BATCH = 10000;
+
+enum benchWorkload {
+    W_PUSH_BACK = 0,
+    W_PUSH_FRONT,
+    W_PUSH_BACK_BULK,
+    W_INSERT_AFTER,
+    W_REMOVE,
+    W_FIND,
+    W_FIND_ANY,
+    W_TRAVERSE,
+    W_SORT,
+    W_COUNT
+};
+
+static const char *workloadNames[W_COUNT] = {
+    "pushBack", "pushFront", "pushBackBulk", "insertAfter", "remove", "find", "findAny", "traverse", "sort"
+};
+
+typedef struct benchResult {
+    size_t ops;         ///< Number of timed operations, 0 if workload was skipped
+    double nsPerOp;     ///< Mean time of one operation
+    size_t allocs;      ///< Allocations made in timed section
+    long   peakRssKb;   ///< Peak RSS of setup + timed section
+} benchResult_t;
+
+/// @brief Number of ops to run when every op costs opCost element visits
+static size_t opsWithinBudget(size_t opCost, size_t maxOps) {
+    double ops = WORK_BUDGET / (double) (opCost ? opCost : 1);
+    if (ops < 1) return 1;
+    return (ops < (double) maxOps) ? (size_t) ops : maxOps;
+}
+
+static volatile double benchSink = 0;
+
+template <typename Container>
+static benchResult_t runWorkload(enum benchWorkload workload, size_t size, uint64_t seed) {
+    benchResult_t result = {};
+    benchRng_t rng(seed);
+    const bool linearOps = Container::shiftsOnInsert;
+
+    resetPeakRss();
+    {
+        Container container;
+
+        size_t ops = 0;
+        switch (workload) {
+        case W_PUSH_BACK:
+        case W_PUSH_FRONT:
+            ops = size;
+            if (workload == W_PUSH_FRONT && linearOps && (double) size * (double) size / 2 > WORK_BUDGET)
+                return result;
+            container.reserveHandles(ops);
+            break;
+        case W_PUSH_BACK_BULK:
+            ops = size;
+            break;
+        case W_INSERT_AFTER:
+        case W_REMOVE:
+            ops = linearOps ? opsWithinBudget(size, MAX_RANDOM_OPS) : MAX_RANDOM_OPS;
+            if (workload == W_REMOVE && ops > size) ops = size;
+            container.reserveHandles(size + ops);
+            break;
+        case W_FIND:
+        case W_FIND_ANY:
+            ops = opsWithinBudget(size, MAX_RANDOM_OPS);
+            container.reserveHandles(size);
+            break;
+        case W_TRAVERSE:
+            ops = opsWithinBudget(size, MAX_RANDOM_OPS);
+            container.reserveHandles(size);
+            break;
+        case W_SORT:
+            ops = size;
+            container.reserveHandles(size);
+            break;
+        case W_COUNT:
+        default:
+            return result;
+        }
+
+        std::vector<double> batch;
+        if (workload == W_PUSH_BACK_BULK)
+            for (size_t idx = 0; idx < BULK_BATCH && idx < size; idx++)
+                batch.push_back((double) idx);
+
+        if (workload == W_SORT)
+            for (size_t idx = 0; idx < size; idx++)
+                container.pushBack((double) (rng() % size));
+        else if (workload != W_PUSH_BACK && workload != W_PUSH_FRONT && workload != W_PUSH_BACK_BULK)
+            for (size_t idx = 0; idx < size; idx++)
+                container.pushBack((double) idx);
+
+        size_t allocsBefore = allocCounter;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        double sum = 0;
+        switch (workload) {
+        case W_PUSH_BACK:
+            for (size_t idx = 0; idx < ops; idx++) container.pushBack((double) idx);
+            break;
+        case W_PUSH_FRONT:
+            for (size_t idx = 0; idx < ops; idx++) container.pushFront((double) idx);
+            break;
+        case W_PUSH_BACK_BULK:
+            // reported per pushed element
+            for (size_t idx = 0; idx < ops; idx += batch.size())
+                container.pushBackBulk(batch.data(), std::min(batch.size(), ops - idx));
+            break;
+        case W_INSERT_AFTER:
+            for (size_t idx = 0; idx < ops; idx++) container.insertRandom(rng, (double) idx);
+            break;
+        case W_REMOVE:
+            for (size_t idx = 0; idx < ops; idx++) container.removeRandom(rng);
+            break;
+        case W_FIND:
+            for (size_t idx = 0; idx < ops; idx++) sum += container.find((double) (rng() % size));
+            break;
+        case W_FIND_ANY:
+            for (size_t idx = 0; idx < ops; idx++) sum += container.findAny((double) (rng() % size));
+            break;
+        case W_TRAVERSE:
+            for (size_t idx = 0; idx < ops; idx++) sum += container.traverse();
+            // traversal is reported per visited element
+            ops *= size;
+            break;
+        case W_SORT:
+            // one sort of random values, reported per element
+            container.sort();
+            break;
+        case W_COUNT:
+        default:
+            break;
+        }
+
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        benchSink = benchSink + sum;
+
+        result.ops     = ops;
+        result.allocs  = allocCounter - allocsBefore;
+        result.nsPerOp = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                         / (double) ops;
+    }
+    result.peakRssKb = readPeakRss();
+    return result;
+}
+
+/// @brief Build listCount lists round-robin, traverse them and destruct, reported per list
+template <typename Lists>
+static benchResult_t runSmallLists(size_t listCount) {
+    benchResult_t result = {};
+    volatile double sum = 0;
+
+    resetPeakRss();
+    size_t allocsBefore = allocCounter;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    {
+        Lists lists(listCount);
+        // round-robin filling interleaves nodes of different lists like real workloads do
+        for (size_t elem = 0; elem < SMALL_LIST_SIZE; elem++)
+            for (size_t listIdx = 0; listIdx < listCount; listIdx++)
+                lists.pushBack(listIdx, (double) elem);
+        sum = lists.traverse();
+        result.peakRssKb = readPeakRss();
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    benchSink = benchSink + sum;
+
+    result.ops     = listCount;
+    result.allocs  = allocCounter - allocsBefore;
+    result.nsPerOp = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                     / (double) listCount;
+    return result;
+}
+
+static void printResult(enum benchWorkload workload, const char *containerName, size_t size, benchResult_t result) {
+    if (result.ops == 0) {
+        printf("%-12s %-12s %10zu %10s\n", workloadNames[workload], containerName, size, "skipped");
+        return;
+    }
+    printf("%-12s %-12s %10zu %10zu %12.2f %10zu %12ld\n",
+           workloadNames[workload], containerName, size, result.ops, result.nsPerOp, result.allocs, result.peakRssKb);
+    fflush(stdout);
+}
+
+/*! @brief Move items from producers to one consumer through queue, reported per item
+    Producer p pushes p, p + producers, ..., so consumer knows next item of every producer.
+    misplaced counts items lost, duplicated or out of order within their producer
+!*/
+template <typename Queue, typename... QueueArgs>
+static benchResult_t runQueue(size_t items, size_t producers, size_t *misplaced, QueueArgs... queueArgs) {
+    benchResult_t result = {};
+    double sum = 0;
+    std::vector<size_t> expected(producers);
+    *misplaced = 0;
+
+    resetPeakRss();
+    {
+        Queue queue(queueArgs...);
+        std::vector<std::thread> threads;
+        threads.reserve(producers);
+        std::atomic<size_t> producersLeft(producers);
+        for (size_t producer = 0; producer < producers; producer++)
+            expected[producer] = producer;
+
+        size_t allocsBefore = allocCounter;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for (size_t producer = 0; producer < producers; producer++)
+            threads.emplace_back([&queue, &producersLeft, items, producers, producer]() {
+                for (size_t item = producer; item < items; item += producers)
+                    queue.push((double) item);
+                producersLeft.fetch_sub(1, std::memory_order_release);
+            });
+
+        // queue found empty after all producers finished means items were lost
+        size_t popped = 0;
+        unsigned attempt = 0;
+        while (popped < items) {
+            double value = 0;
+            if (!queue.tryPop(&value)) {
+                if (producersLeft.load(std::memory_order_acquire) == 0 && !queue.tryPop(&value))
+                    break;
+                queueWait(&attempt);
+                continue;
+            }
+            attempt = 0;
+            popped++;
+            sum += value;
+
+            size_t item = (size_t) value;
+            size_t producer = (producers == 1) ? 0 : item % producers;
+            if (item != expected[producer])
+                (*misplaced)++;
+            expected[producer] = item + producers;
+        }
+        for (std::thread &thread : threads)
+            thread.join();
+        *misplaced += items - popped;
+
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        result.ops     = items;
+        result.allocs  = allocCounter - allocsBefore;
+        result.nsPerOp = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                         / (double) items;
+    }
+    benchSink = benchSink + sum;
+    result.peakRssKb = readPeakRss();
+    return result;
+}
+
+/// @return false if some items were misplaced
+static bool printQueueResult(const char *containerName, size_t producers, size_t items,
+                             benchResult_t result, size_t misplaced) {
+    char name[32] = "";
+    snprintf(name, sizeof(name), "%s %zup", containerName, producers);
+    printf("%-12s %-12s %10zu %10zu %12.2f %10zu %12ld\n",
+           "queue", name, items, result.ops, result.nsPerOp, result.allocs, result.peakRssKb);
+    if (misplaced)
+        printf("queue: %zu items of %s were lost, duplicated or reordered\n", misplaced, name);
+    fflush(stdout);
+    return misplaced == 0;
+}
+
+/*! @brief Readers traverse list while writer updates it, reported per visited element
+    @param inconsistent [out] Number of traversals that saw wrong sum
+!*/
+template <typename Shared>
+static benchResult_t runShared(size_t size, size_t readers, uint64_t seed, size_t *inconsistent) {
+    benchResult_t result = {};
+    std::atomic<size_t> wrongSums(0);
+    std::atomic<bool>   readersDone(false);
+
+    resetPeakRss();
+    {
+        Shared shared;
+        double expected = 0;
+        for (size_t idx = 0; idx < size; idx++) {
+            shared.pushBack((double) idx);
+            expected += (double) idx;
+        }
+        // every sum is made of the same integers, so it is exact in any order
+        size_t traversals = (size_t) (SHARED_VISITS / (double) (size * readers));
+        if (traversals == 0) traversals = 1;
+
+        size_t allocsBefore = allocCounter;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        std::thread writer([&shared, &readersDone, seed]() {
+            benchRng_t rng(seed);
+            sharedUpdate_t update = {&rng, 0};
+            while (!readersDone.load(std::memory_order_relaxed)) {
+                shared.update(&update);
+                std::this_thread::sleep_for(SHARED_WRITER_PAUSE);
+            }
+        });
+        std::vector<std::thread> threads;
+        for (size_t reader = 0; reader < readers; reader++)
+            threads.emplace_back([&shared, &wrongSums, traversals, expected]() {
+                for (size_t idx = 0; idx < traversals; idx++)
+                    if (shared.sum() != expected)
+                        wrongSums++;
+            });
+        for (std::thread &thread : threads)
+            thread.join();
+        readersDone = true;
+        writer.join();
+
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        result.ops     = traversals * readers * size;
+        result.allocs  = allocCounter - allocsBefore;
+        result.nsPerOp = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                         / (double) result.ops;
+    }
+    result.peakRssKb = readPeakRss();
+    *inconsistent = wrongSums;
+    return result;
+}
+
+static void printSharedResult(const char *containerName, size_t readers, size_t size,
+                              benchResult_t result, size_t inconsistent) {
+    char name[32] = "";
+    snprintf(name, sizeof(name), "%s %zur", containerName, readers);
+    printf("%-12s %-12s %10zu %10zu %12.2f %10zu %12ld\n",
+           "shared", name, size, result.ops, result.nsPerOp, result.allocs, result.peakRssKb);
+    if (inconsistent)
+        printf("shared: %zu traversals of %s saw inconsistent list\n", inconsistent, name);
+    fflush(stdout);
+}
+
+/*------------------PARALLEL REDUCE-------------------------------------------*/
+
+enum reduceMode {
+    REDUCE_SEQUENTIAL = 0,  ///< Cursor walk by next in one thread
+    REDUCE_ANY_ORDER,
+    REDUCE_IN_ORDER,
+    REDUCE_MODE_COUNT
+};
+
+static const char *reduceModeNames[REDUCE_MODE_COUNT] = {"sequential", "anyOrder", "inOrder"};
+
+static void sumStep(void *acc, const void *elem, void *) {
+    *(double *) acc += *(const double *) elem;
+}
+
+static void sumCombine(void *acc, const void *other, void *) {
+    *(double *) acc += *(const double *) other;
+}
+
+/// @brief Sum of scrambled list of size elements, reported per element
+static benchResult_t runReduce(enum reduceMode mode, size_t size, uint64_t seed) {
+    benchResult_t result = {};
+    benchRng_t rng(seed);
+
+    resetPeakRss();
+    {
+        // random inserts scatter logical order over slots, then some slots are freed
+        cListBench<LIST_LAYOUT_SOA> list;
+        list.reserveHandles(size + size / 4);
+        list.pushBack(0);
+        for (size_t idx = 1; idx < size + size / 4; idx++)
+            list.insertRandom(rng, (double) idx);
+        for (size_t idx = 0; idx < size / 4; idx++)
+            list.removeRandom(rng);
+
+        size_t passes = opsWithinBudget(size, MAX_RANDOM_OPS) / 10 + 1;
+        double sum = 0;
+
+        size_t allocsBefore = allocCounter;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t pass = 0; pass < passes; pass++) {
+            double passSum = 0, zero = 0;
+            if (mode == REDUCE_SEQUENTIAL)
+                passSum = list.traverse();
+            else
+                listParallelReduce(list.raw(), &passSum, sizeof(passSum), &zero, sumStep, sumCombine, NULL,
+                                   (mode == REDUCE_IN_ORDER) ? LIST_PARALLEL_IN_ORDER : LIST_PARALLEL_ANY_ORDER, 0);
+            sum += passSum;
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        benchSink = benchSink + sum;
+
+        result.ops     = passes * size;
+        result.allocs  = allocCounter - allocsBefore;
+        result.nsPerOp = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                         / (double) result.ops;
+    }
+    result.peakRssKb = readPeakRss();
+    return result;
+}
+
+/*------------------WARM RESTART FROM FILE------------------------------------*/
+
+/// File written by mapLoad workload, removed after it
+static const char *MAP_LOAD_FILE = "benchList.bin";
+
+/// @brief Load list of size elements and sum it once, reported per element
+/// @param mapped Map list saved by listSaveToFile instead of rebuilding it by pushBack
+static benchResult_t runMapLoad(bool mapped, size_t size) {
+    benchResult_t result = {};
+    std::vector<double> values(size);
+    for (size_t idx = 0; idx < size; idx++)
+        values[idx] = (double) idx;
+    {
+        cListBench<LIST_LAYOUT_SOA> list;
+        list.pushBackBulk(values.data(), size);
+        listSaveToFile(list.raw(), MAP_LOAD_FILE);
+    }
+
+    resetPeakRss();
+    size_t passes = opsWithinBudget(size, MAX_RANDOM_OPS) / 10 + 1;
+    double sum = 0;
+
+    size_t allocsBefore = allocCounter;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t pass = 0; pass < passes; pass++) {
+        cList_t list = {};
+        if (mapped) {
+            listMapFile(&list, MAP_LOAD_FILE, NULL);
+        } else {
+            listCtor(&list, sizeof(double), NULL);
+            for (size_t idx = 0; idx < size; idx++)
+                listPushBack(&list, &values[idx]);
+        }
+        for (listCursor_t cursor = listCursorBegin(&list); listCursorValid(&cursor); listCursorNext(&cursor))
+            sum += *(double *) listCursorGet(&cursor);
+        listDtor(&list);
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    benchSink = benchSink + sum;
+
+    result.ops       = passes * size;
+    result.allocs    = allocCounter - allocsBefore;
+    result.nsPerOp   = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                       / (double) result.ops;
+    result.peakRssKb = readPeakRss();
+    remove(MAP_LOAD_FILE);
+    return result;
+}
+
+/*------------------OPERATION JOURNAL-----------------------------------------*/
+
+enum journalMode {
+    JOURNAL_OFF = 0,
+    JOURNAL_BUFFERED,       ///< Records written when buffer fills, no fdatasync
+    JOURNAL_SYNC_BATCH,     ///< fdatasync every JOURNAL_SYNC_BATCH_RECORDS records
+    JOURNAL_SYNC_EACH,      ///< fdatasync after every record
+    JOURNAL_SNAPSHOT,       ///< Whole list saved by listSaveToFile instead, once per run
+    JOURNAL_MODE_COUNT
+};
+
+static const char *journalModeNames[JOURNAL_MODE_COUNT] = {"off", "buffered", "syncBatch", "syncEach", "snapshot"};
+
+const uint32_t JOURNAL_SYNC_BATCH_RECORDS = 1000;
+/// fdatasync per record costs milliseconds on real disks
+const size_t   JOURNAL_SYNC_EACH_OPS = 1000;
+static const char *JOURNAL_FILE  = "benchJournal.bin";
+static const char *SNAPSHOT_FILE = "benchSnapshot.bin";
+
+/// @brief Random inserts and removals in list of size elements with journal in given mode
+static benchResult_t runJournal(enum journalMode mode, size_t size, uint64_t seed) {
+    benchResult_t result = {};
+    benchRng_t rng(seed);
+
+    resetPeakRss();
+    {
+        cListBench<LIST_LAYOUT_SOA> list;
+        list.reserveHandles(size + 1);
+        for (size_t idx = 0; idx < size; idx++)
+            list.pushBack((double) idx);
+
+        listJournalPolicy_t policy = LIST_DEFAULT_JOURNAL_POLICY;
+        if (mode == JOURNAL_SYNC_BATCH) policy.recordsPerSync = JOURNAL_SYNC_BATCH_RECORDS;
+        if (mode == JOURNAL_SYNC_EACH)  policy.recordsPerSync = 1;
+        if (mode != JOURNAL_OFF && mode != JOURNAL_SNAPSHOT)
+            listJournalAttach(list.raw(), JOURNAL_FILE, policy);
+
+        size_t ops = (mode == JOURNAL_SNAPSHOT) ? 1 : std::min(size, MAX_RANDOM_OPS);
+        if (mode == JOURNAL_SYNC_EACH)
+            ops = std::min(ops, JOURNAL_SYNC_EACH_OPS);
+
+        size_t allocsBefore = allocCounter;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (mode == JOURNAL_SNAPSHOT) {
+            listSaveToFile(list.raw(), SNAPSHOT_FILE);
+        } else {
+            for (size_t op = 0; op < ops; op++) {
+                if (op % 2 == 0)
+                    list.insertRandom(rng, (double) op);
+                else
+                    list.removeRandom(rng);
+            }
+            if (mode != JOURNAL_OFF)
+                listJournalSync(list.raw());
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        listJournalDetach(list.raw());
+
+        result.ops     = ops;
+        result.allocs  = allocCounter - allocsBefore;
+        result.nsPerOp = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                         / (double) result.ops;
+    }
+    result.peakRssKb = readPeakRss();
+    remove(JOURNAL_FILE);
+    remove(SNAPSHOT_FILE);
+    return result;
+}
+
+/*------------------CLONE AND SNAPSHOT----------------------------------------*/
+
+enum snapshotMode {
+    SNAPSHOT_CLONE = 0,     ///< listClone, then list is modified
+    SNAPSHOT_FROZEN,        ///< listSnapshot, list isn't modified before snapshot is released
+    SNAPSHOT_WRITE,         ///< listSnapshot, then list is modified and copies block
+    SNAPSHOT_MODE_COUNT
+};
+
+static const char *snapshotModeNames[SNAPSHOT_MODE_COUNT] = {"listClone", "snapshot", "snap+write"};
+
+/// @brief Consistent copy of list of size elements for exporter, reported per copy
+static benchResult_t runSnapshot(enum snapshotMode mode, size_t size) {
+    benchResult_t result = {};
+
+    resetPeakRss();
+    {
+        cListBench<LIST_LAYOUT_SOA> list;
+        for (size_t idx = 0; idx < size; idx++)
+            list.pushBack((double) idx);
+
+        size_t passes = opsWithinBudget(size, MAX_RANDOM_OPS) / 10 + 1;
+        double sum = 0;
+
+        size_t allocsBefore = allocCounter;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (size_t pass = 0; pass < passes; pass++) {
+            cList_t copy = {};
+            if (mode == SNAPSHOT_CLONE)
+                listClone(&copy, list.raw());
+            else
+                listSnapshot(list.raw(), &copy);
+
+            // writer goes on while exporter still holds its copy
+            if (mode != SNAPSHOT_FROZEN) {
+                list.pushBack((double) pass);
+                listPopBack(list.raw());
+            }
+            sum += *(double *) listGet(&copy, listBack(&copy));
+            listDtor(&copy);
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        benchSink = benchSink + sum;
+
+        result.ops     = passes;
+        result.allocs  = allocCounter - allocsBefore;
+        result.nsPerOp = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                         / (double) result.ops;
+    }
+    result.peakRssKb = readPeakRss();
+    return result;
+}
+
+/*------------------INDEX WIDTH-----------------------------------------------*/
+
+/// Elements in every list of width workload, fits into int16_t indices
+const size_t WIDTH_LIST_SIZE = 1000;
+
+/// @brief listCount lists of WIDTH_LIST_SIZE int32_t elements with Index links:
+///        build, then rotate every list (pop front, push back) and sum it
+template <typename Index>
+static benchResult_t runWidth(size_t listCount) {
+    benchResult_t result = {};
+
+    resetPeakRss();
+    {
+        size_t allocsBefore = allocCounter;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        std::vector<clist::cList<int32_t, Index> > lists(listCount);
+        for (size_t list = 0; list < listCount; list++)
+            for (size_t elem = 0; elem < WIDTH_LIST_SIZE; elem++)
+                lists[list].pushBack((int32_t) elem);
+
+        int64_t sum = 0;
+        for (size_t list = 0; list < listCount; list++) {
+            clist::cList<int32_t, Index> &current = lists[list];
+            for (size_t elem = 0; elem < WIDTH_LIST_SIZE / 10; elem++) {
+                int32_t value = current[current.front()];
+                current.popFront();
+                current.pushBack(value);
+            }
+            for (int32_t elem : current)
+                sum += elem;
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        benchSink = benchSink + (double) sum;
+
+        // pushes, rotations and visited elements
+        result.ops     = listCount * (WIDTH_LIST_SIZE + WIDTH_LIST_SIZE / 10 * 2 + WIDTH_LIST_SIZE);
+        result.allocs  = allocCounter - allocsBefore;
+        result.nsPerOp = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                         / (double) result.ops;
+    }
+    result.peakRssKb = readPeakRss();
+    return result;
+}
+
+/*------------------XOR-LINKED LIST-------------------------------------------*/
+
+/// @brief List of size int32_t elements: build, rotate (pop front, push back) and sum it,
+///        cList_t with next and prev links vs listXor_t with one xor link
+static benchResult_t runXor(bool xorLinked, size_t size) {
+    benchResult_t result = {};
+
+    resetPeakRss();
+    {
+        size_t passes = opsWithinBudget(size, MAX_RANDOM_OPS) / 10 + 1;
+        size_t rotations = size / 10 + 1;
+        int64_t sum = 0;
+
+        size_t allocsBefore = allocCounter;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (xorLinked) {
+            listXor_t list = {};
+            listXorCtor(&list, sizeof(int32_t), NULL);
+            listXorSetVerifyLevel(&list, LIST_VERIFY_OFF, 0);
+            for (int32_t elem = 0; elem < (int32_t) size; elem++)
+                listXorPushBack(&list, &elem);
+
+            for (size_t pass = 0; pass < passes; pass++) {
+                for (size_t rotation = 0; rotation < rotations; rotation++) {
+                    int32_t value = 0;
+                    listXorPopFront(&list, &value);
+                    listXorPushBack(&list, &value);
+                }
+                listXorCursor_t cursor = listXorBegin(&list);
+                for (; cursor.cur != NULL_LIST_IT; listXorNextOf(&list, &cursor))
+                    sum += *(int32_t *) listXorDataOf(&list, cursor.cur);
+            }
+            listXorDtor(&list);
+        } else {
+            cList_t list = {};
+            listCtor(&list, sizeof(int32_t), NULL, LIST_LAYOUT_SOA);
+            listSetVerifyLevel(&list, LIST_VERIFY_OFF, 0);
+            for (int32_t elem = 0; elem < (int32_t) size; elem++)
+                listPushBack(&list, &elem);
+
+            for (size_t pass = 0; pass < passes; pass++) {
+                for (size_t rotation = 0; rotation < rotations; rotation++) {
+                    int32_t value = *(int32_t *) listGet(&list, listFront(&list));
+                    listPopFront(&list);
+                    listPushBack(&list, &value);
+                }
+                for (listIterator_t iter = listNextOf(&list, 0); iter != NULL_LIST_IT; iter = listNextOf(&list, iter))
+                    sum += *(int32_t *) listDataOf(&list, iter);
+            }
+            listDtor(&list);
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        benchSink = benchSink + (double) sum;
+
+        // pushes, then rotations and visited elements of every pass
+        result.ops     = size + passes * (rotations * 2 + size);
+        result.allocs  = allocCounter - allocsBefore;
+        result.nsPerOp = (double) std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()
+                         / (double) result.ops;
+    }
+    result.peakRssKb = readPeakRss();
+    return result;
+}
+
+static void printSmallListsResult(const char *containerName, size_t listCount, benchResult_t result) {
+    printf("%-12s %-12s %10zu %10zu %12.2f %10zu %12ld\n",
+           "smallLists", containerName, listCount, result.ops, result.nsPerOp, result.allocs, result.peakRssKb);
+    fflush(stdout);
+}
+
+int main(int argc, const char *argv[]) {
+    logOpen("bench.txt", L_TXT_MODE);
+    setLogLevel(L_ZERO);
+
+    enableHelpFlag("cList benchmark: cList_t and cList<T> vs std::list vs std::vector\n");
+    registerFlag(TYPE_INT, "-m", "--min-size", "smallest list size (default 10)");
+    registerFlag(TYPE_INT, "-M", "--max-size", "largest list size (default 10000000)");
+    registerFlag(TYPE_INT, "-s", "--seed",     "random seed");
+    registerFlag(TYPE_STRING, "-w", "--workload", "run only given workload (pushBack, find, ..., smallLists, queue, shared, reduce, mapLoad, journal, snapshot, width, xor)");
+    enum argvStatus argvRes = processArgs(argc, argv);
+    if (argvRes != ARGV_SUCCESS) {
+        logClose();
+        return (argvRes == ARGV_HELP_MSG) ? 0 : 1;
+    }
+
+    size_t minSize = isFlagSet("-m") ? (size_t) getFlagValue("-m").int_ : 10;
+    size_t maxSize = isFlagSet("-M") ? (size_t) getFlagValue("-M").int_ : 10000000;
+    uint64_t seed  = isFlagSet("-s") ? (uint64_t) getFlagValue("-s").int_ : 2024;
+    const char *onlyWorkload = isFlagSet("-w") ? getFlagValue("-w").string_ : NULL;
+
+    printf("%-12s %-12s %10s %10s %12s %10s %12s\n",
+           "workload", "container", "size", "ops", "ns/op", "allocs", "peakRSS,KiB");
+
+    for (int workloadIdx = 0; workloadIdx < W_COUNT; workloadIdx++) {
+        enum benchWorkload workload = (enum benchWorkload) workloadIdx;
+        if (onlyWorkload && strcmp(onlyWorkload, workloadNames[workload]) != 0)
+            continue;
+
+        for (size_t size = minSize; size <= maxSize; size *= 10) {
+            printResult(workload, cListBench<LIST_LAYOUT_SOA>::name(), size,
+                        runWorkload<cListBench<LIST_LAYOUT_SOA> >(workload, size, seed));
+            printResult(workload, cListBench<LIST_LAYOUT_AOS>::name(), size,
+                        runWorkload<cListBench<LIST_LAYOUT_AOS> >(workload, size, seed));
+            printResult(workload, cListBench<LIST_LAYOUT_SOA, true>::name(), size,
+                        runWorkload<cListBench<LIST_LAYOUT_SOA, true> >(workload, size, seed));
+            printResult(workload, cListTBench::name(),    size, runWorkload<cListTBench>   (workload, size, seed));
+            printResult(workload, stdListBench::name(),   size, runWorkload<stdListBench>  (workload, size, seed));
+            printResult(workload, stdVectorBench::name(), size, runWorkload<stdVectorBench>(workload, size, seed));
+        }
+    }
+
+    // size is number of lists here, every list has SMALL_LIST_SIZE elements
+    if (!onlyWorkload || strcmp(onlyWorkload, "smallLists") == 0) {
+        for (size_t size = minSize; size <= maxSize && size <= SMALL_LISTS_MAX; size *= 10) {
+            printSmallListsResult(cListManyBench::name(),    size, runSmallLists<cListManyBench>   (size));
+            printSmallListsResult(poolListManyBench::name(), size, runSmallLists<poolListManyBench>(size));
+            printSmallListsResult(stdListManyBench::name(),  size, runSmallLists<stdListManyBench> (size));
+        }
+    }
+
+    // size is number of items moved from producers to consumer, "1p" is one producer
+    bool queueCorrect = true;
+    if (!onlyWorkload || strcmp(onlyWorkload, "queue") == 0) {
+        // first thread of process maps new stack, SPSC runs first and would pay for it alone
+        std::thread([]() {}).join();
+        for (size_t size = std::max<size_t>(minSize, 1000); size <= maxSize; size *= 10) {
+            size_t misplaced = 0;
+            benchResult_t result = runQueue<lockFreeQueueBench>(size, 1, &misplaced, LIST_QUEUE_SPSC);
+            queueCorrect &= printQueueResult("SPSC", 1, size, result, misplaced);
+            for (size_t producers = 1; producers <= QUEUE_MAX_PRODUCERS; producers *= 2) {
+                result = runQueue<lockFreeQueueBench>(size, producers, &misplaced, LIST_QUEUE_MPSC);
+                queueCorrect &= printQueueResult("MPSC", producers, size, result, misplaced);
+                result = runQueue<mutexListBench>(size, producers, &misplaced);
+                queueCorrect &= printQueueResult("mutex", producers, size, result, misplaced);
+            }
+        }
+    }
+
+    // every pass sums whole list, parallel modes use all hardware threads
+    if (!onlyWorkload || strcmp(onlyWorkload, "reduce") == 0) {
+        for (size_t size = std::max<size_t>(minSize, 1000); size <= maxSize; size *= 10) {
+            for (int mode = 0; mode < REDUCE_MODE_COUNT; mode++) {
+                benchResult_t result = runReduce((enum reduceMode) mode, size, seed);
+                printf("%-12s %-12s %10zu %10zu %12.2f %10zu %12ld\n", "reduce", reduceModeNames[mode],
+                       size, result.ops, result.nsPerOp, result.allocs, result.peakRssKb);
+                fflush(stdout);
+            }
+        }
+    }
+
+    // every pass loads whole list from scratch and sums it, file stays in page cache
+    if (!onlyWorkload || strcmp(onlyWorkload, "mapLoad") == 0) {
+        for (size_t size = std::max<size_t>(minSize, 1000); size <= maxSize; size *= 10) {
+            for (int mapped = 0; mapped <= 1; mapped++) {
+                benchResult_t result = runMapLoad(mapped, size);
+                printf("%-12s %-12s %10zu %10zu %12.2f %10zu %12ld\n", "mapLoad", mapped ? "listMapFile" : "pushBack",
+                       size, result.ops, result.nsPerOp, result.allocs, result.peakRssKb);
+                fflush(stdout);
+            }
+        }
+    }
+
+    // half of operations insert, half remove, "snapshot" is one full save of the same list
+    if (!onlyWorkload || strcmp(onlyWorkload, "journal") == 0) {
+        for (size_t size = std::max<size_t>(minSize, 1000); size <= maxSize; size *= 10) {
+            for (int mode = 0; mode < JOURNAL_MODE_COUNT; mode++) {
+                benchResult_t result = runJournal((enum journalMode) mode, size, seed);
+                printf("%-12s %-12s %10zu %10zu %12.2f %10zu %12ld\n", "journal", journalModeNames[mode],
+                       size, result.ops, result.nsPerOp, result.allocs, result.peakRssKb);
+                fflush(stdout);
+            }
+        }
+    }
+
+    // every pass takes consistent copy of list while list keeps changing, ns/op is per copy
+    if (!onlyWorkload || strcmp(onlyWorkload, "snapshot") == 0) {
+        for (size_t size = std::max<size_t>(minSize, 1000); size <= maxSize; size *= 10) {
+            for (int mode = 0; mode < SNAPSHOT_MODE_COUNT; mode++) {
+                benchResult_t result = runSnapshot((enum snapshotMode) mode, size);
+                printf("%-12s %-12s %10zu %10zu %12.2f %10zu %12ld\n", "snapshot", snapshotModeNames[mode],
+                       size, result.ops, result.nsPerOp, result.allocs, result.peakRssKb);
+                fflush(stdout);
+            }
+        }
+    }
+
+    // size is number of lists, every list has WIDTH_LIST_SIZE elements, "idx16" links them by int16_t
+    if (!onlyWorkload || strcmp(onlyWorkload, "width") == 0) {
+        for (size_t size = minSize; size <= maxSize && size <= SMALL_LISTS_MAX / 100; size *= 10) {
+            const char *names[] = {"idx16", "idx32", "idx64"};
+            benchResult_t results[] = {runWidth<int16_t>(size), runWidth<int32_t>(size), runWidth<int64_t>(size)};
+            for (size_t width = 0; width < 3; width++) {
+                printf("%-12s %-12s %10zu %10zu %12.2f %10zu %12ld\n", "width", names[width],
+                       size, results[width].ops, results[width].nsPerOp, results[width].allocs, results[width].peakRssKb);
+                fflush(stdout);
+            }
+        }
+    }
+
+    // every pass rotates tenth of list and sums it, int32_t payloads make links most of memory
+    if (!onlyWorkload || strcmp(onlyWorkload, "xor") == 0) {
+        for (size_t size = std::max<size_t>(minSize, 1000); size <= maxSize; size *= 10) {
+            for (int xorLinked = 0; xorLinked <= 1; xorLinked++) {
+                benchResult_t result = runXor(xorLinked, size);
+                printf("%-12s %-12s %10zu %10zu %12.2f %10zu %12ld\n", "xor", xorLinked ? "listXor_t" : "cList_t",
+                       size, result.ops, result.nsPerOp, result.allocs, result.peakRssKb);
+                fflush(stdout);
+            }
+        }
+    }
+
+    // size is list length, "4r" is four reader threads, one writer runs alongside them
+    if (!onlyWorkload || strcmp(onlyWorkload, "shared") == 0) {
+        for (size_t size = std::max<size_t>(minSize, 100); size <= maxSize && size <= SHARED_VISITS; size *= 10) {
+            for (size_t readers = 1; readers <= SHARED_MAX_READERS; readers *= 2) {
+                size_t inconsistent = 0;
+                benchResult_t result = runShared<rwlockListBench>(size, readers, seed, &inconsistent);
+                printSharedResult(rwlockListBench::name(), readers, size, result, inconsistent);
+                result = runShared<mutexReadListBench>(size, readers, seed, &inconsistent);
+                printSharedResult(mutexReadListBench::name(), readers, size, result, inconsistent);
+            }
+        }
+    }
+
+    logClose();
+    return queueCorrect ? 0 : 1;
+}
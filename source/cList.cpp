@@ -1,11 +1,22 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include <stdbool.h>
+#include <atomic>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "error_debug.h"
 #include "logger.h"
+#include "utils.h"
 #include "cList.h"
+#include "cListIndex.h"
+#include "cListJournal.h"
 
 const size_t INTERNAL_BUFFER_SIZE = 100;
 
@@ -14,87 +25,287 @@ static bool checkIfInvalidIterator(cList_t *list, listIterator_t iter) {
     return (iter < 0 || iter > list->reserved);
 }
 
-static enum listStatus listRealloc(cList_t *list) {
-    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
-    LIST_ASSERT(list);
-    logPrint(L_DEBUG, 0, "Reallocating list [%p]: %d -> %d\n", list, list->reserved, list->reserved * 2);
+/// @brief Fill payloads of slots [from, to] with LIST_POISON, works only if LIST_POISONING is defined
+static void listPoison(cList_t *list, int32_t from, int32_t to) {
+#ifdef LIST_POISONING
+    for (int32_t idx = from; idx <= to; idx++) {
+        char *elem = (char *) listDataOf(list, idx);
+        for (size_t offset = 0; offset < list->elemSize; offset += sizeof(LIST_POISON)) {
+            size_t chunk = list->elemSize - offset;
+            memcpy(elem + offset, &LIST_POISON, (chunk < sizeof(LIST_POISON)) ? chunk : sizeof(LIST_POISON));
+        }
+    }
+#else
+    (void) list; (void) from; (void) to;
+#endif
+}
 
-    // + 1 because NULL list element isn't counted
-    size_t newCapacity = (list->reserved * 2 + 1);
+static bool listIsPoisoned(cList_t *list, int32_t idx) {
+    const char *elem = (const char *) listDataOf(list, idx);
+    for (size_t offset = 0; offset < list->elemSize; offset += sizeof(LIST_POISON)) {
+        size_t chunk = list->elemSize - offset;
+        if (memcmp(elem + offset, &LIST_POISON, (chunk < sizeof(LIST_POISON)) ? chunk : sizeof(LIST_POISON)) != 0)
+            return false;
+    }
+    return true;
+}
 
-    int32_t *newNext = (int32_t *) realloc(list->next, sizeof(int32_t) * newCapacity);
-    if (!newNext) {
-        logPrint(L_ZERO, 1, "Reallocation of cList_t[%p]::next[%p] failed\n", list, list->next);
-        return LIST_MEMORY_ERROR;
+/// @brief Take slot for new element: from free sequence first, then from untouched region
+/// @return NULL_LIST_IT if there are no free slots
+static listIterator_t listTakeFree(cList_t *list) {
+    if (list->free != NULL_LIST_IT) {
+        listIterator_t slot = list->free;
+        list->free = listNextOf(list, slot);
+        return slot;
+    }
+    if (list->untouched <= list->reserved)
+        return list->untouched++;
+    return NULL_LIST_IT;
+}
+
+/// @brief Offset of data array in LIST_LAYOUT_SOA storage block of capacity nodes
+/// Block layout: next[capacity] | prev[capacity] | padding | data[capacity]
+static size_t listDataOffset(size_t capacity) {
+    const size_t align = alignof(max_align_t);
+    size_t linksSize = 2 * capacity * sizeof(int32_t);
+    return (linksSize + align - 1) / align * align;
+}
+
+/// @brief Size of LIST_LAYOUT_AOS node: next | prev | payload, padded to whole links
+static size_t listNodeSize(size_t elemSize) {
+    return (2 * sizeof(int32_t) + elemSize + sizeof(int32_t) - 1) / sizeof(int32_t) * sizeof(int32_t);
+}
+
+static size_t listStorageSize(const cList_t *list, size_t capacity) {
+    if (list->layout == LIST_LAYOUT_AOS)
+        return capacity * list->nodeSize;
+    return listDataOffset(capacity) + capacity * list->elemSize;
+}
+
+/// @brief Point next, prev and data to their places in storage block
+static void listSetStorage(cList_t *list, char *block, size_t capacity) {
+    list->next = (int32_t *) block;
+    if (list->layout == LIST_LAYOUT_AOS) {
+        list->prev = list->next + 1;
+        list->data = block + 2 * sizeof(int32_t);
+    } else {
+        list->prev = list->next + capacity;
+        list->data = block + listDataOffset(capacity);
+    }
+}
+
+/// @brief Storage block shared by list and its snapshots, freed by the last of them
+typedef struct listStorageShare {
+    std::atomic<int32_t> refs;
+    char    *block;
+    void    *mapping;       ///< File mapping holding block, NULL if block is allocated on heap
+    size_t   mappingSize;
+} listStorageShare_t;
+
+/// @brief Free storage block owned by nobody else
+static void listFreeBlock(const cList_t *list, char *block, void *mapping, size_t mappingSize) {
+    if (!mapping)
+        free(block);
+    else if (munmap(mapping, mappingSize) != 0)
+        logPrint(L_ZERO, 1, "Unmapping storage of cList_t[%p] failed\n", list);
+}
+
+/// @brief Drop list's reference to shared block, the last reference frees it
+static void listDropShare(cList_t *list) {
+    listStorageShare_t *share = list->shared;
+    list->shared = NULL;
+    // acq_rel: reads of block by other owners happen before it is freed
+    if (share->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        listFreeBlock(list, share->block, share->mapping, share->mappingSize);
+        delete share;
+    }
+}
+
+/// @brief Take shared block back if all snapshots have released it
+/// @return true if list owns its storage block alone
+static bool listReclaimStorage(cList_t *list) {
+    listStorageShare_t *share = list->shared;
+    if (!share)
+        return true;
+    if (share->refs.load(std::memory_order_acquire) != 1)
+        return false;
+
+    list->mapping     = share->mapping;
+    list->mappingSize = share->mappingSize;
+    list->shared = NULL;
+    delete share;
+    return true;
+}
+
+/// @brief Free storage block or drop reference to it, pointers to storage become invalid
+static void listReleaseStorage(cList_t *list) {
+    if (list->shared) {
+        listDropShare(list);
+    } else {
+        listFreeBlock(list, (char *) list->next, list->mapping, list->mappingSize);
+        list->mapping     = NULL;
+        list->mappingSize = 0;
     }
-    list->next = newNext;
+}
+
+/*! @brief Resize storage block as realloc does
+    Block mapped from file or shared with snapshots is copied to heap and released
+    @return New block, NULL if allocation failed and old block is kept
+!*/
+static char *listReallocStorage(cList_t *list, size_t oldSize, size_t newSize) {
+    if (listReclaimStorage(list) && !list->mapping)
+        return (char *) realloc(list->next, newSize);
+
+    char *block = (char *) malloc(newSize);
+    if (!block)
+        return NULL;
+    memcpy(block, list->next, (oldSize < newSize) ? oldSize : newSize);
+    listReleaseStorage(list);
+    return block;
+}
 
-    int32_t *newPrev = (int32_t *) realloc(list->prev, sizeof(int32_t) * newCapacity);
-    if (!newPrev) {
-        logPrint(L_ZERO, 1, "Reallocation of cList_t[%p]::prev[%p] failed\n", list, list->prev);
+enum listStatus listMakeWritable(cList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    if (listReclaimStorage(list))
+        return LIST_SUCCESS;
+
+    size_t capacity = (size_t) list->reserved + 1,
+           size     = listStorageSize(list, capacity);
+    logPrint(L_DEBUG, 0, "Copying storage of list [%p] shared with snapshot\n", list);
+
+    char *block = (char *) malloc(size);
+    if (!block) {
+        logPrint(L_ZERO, 1, "Copying shared storage of cList_t[%p] failed\n", list);
         return LIST_MEMORY_ERROR;
     }
-    list->prev = newPrev;
+    memcpy(block, list->next, size);
+    listDropShare(list);
+    listSetStorage(list, block, capacity);
+    return LIST_SUCCESS;
+}
 
-    void *newData = realloc(list->data, list->elemSize * newCapacity);
-    if (!newData) {
-        logPrint(L_ZERO, 1, "Reallocation of cList_t[%p]::data[%p] failed\n", list, list->data);
+/// @brief Give list new storage block of the same capacity instead of shared one, contents aren't copied
+static enum listStatus listDetachStorage(cList_t *list) {
+    size_t capacity = (size_t) list->reserved + 1;
+    logPrint(L_DEBUG, 0, "Detaching storage of list [%p] from snapshot\n", list);
+
+    char *block = (char *) malloc(listStorageSize(list, capacity));
+    if (!block) {
+        logPrint(L_ZERO, 1, "Allocating new storage of cList_t[%p] failed\n", list);
         return LIST_MEMORY_ERROR;
     }
-    list->data = newData;
+    listDropShare(list);
+    listSetStorage(list, block, capacity);
+    listPoison(list, 0, 0);
+    return LIST_SUCCESS;
+}
 
-    for (int32_t idx = list->reserved + 1; idx <= list->reserved * 2; idx++) {
-        list->prev[idx] = INVALID_LIST_IT;
-        list->next[idx] = idx + 1; //free elements
-        memcpy((char *)list->data + list->elemSize*idx, &LIST_POISON, list->elemSize);
+/// @brief Set layout fields of list with elements of elemSize
+static void listSetLayout(cList_t *list, size_t elemSize, enum listLayout layout) {
+    list->elemSize = elemSize;
+    list->layout   = layout;
+    if (layout == LIST_LAYOUT_AOS) {
+        list->nodeSize   = listNodeSize(elemSize);
+        list->linkStride = list->nodeSize / sizeof(int32_t);
+    } else {
+        list->nodeSize   = elemSize;
+        list->linkStride = 1;
     }
+}
 
-    list->next[list->reserved * 2] = NULL_LIST_IT;
+/// @brief Grow storage to newReserved elements, new slots join untouched region without initialization
+static enum listStatus listResize(cList_t *list, int32_t newReserved) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+    if (newReserved <= list->reserved)
+        return LIST_SUCCESS;
+
+    logPrint(L_DEBUG, 0, "Reallocating list [%p]: %d -> %d\n", list, list->reserved, newReserved);
+
+    // + 1 because NULL list element isn't counted
+    size_t oldCapacity = (size_t) list->reserved + 1,
+           newCapacity = (size_t) newReserved + 1;
+
+    // index grows first, its failure leaves list untouched
+    if (list->index && listIndexReserve(list, newCapacity) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
 
-    if (list->free == NULL_LIST_IT)
-        list->free = list->reserved + 1;
-    else {
-        listIterator_t it = list->free;
-        while (list->next[it] != NULL_LIST_IT)
-            it = list->next[it];
-        list->next[it] = list->reserved + 1;
+    char *block = listReallocStorage(list, listStorageSize(list, oldCapacity), listStorageSize(list, newCapacity));
+    if (!block) {
+        logPrint(L_ZERO, 1, "Reallocation of cList_t[%p] storage[%p] failed\n", list, list->next);
+        return LIST_MEMORY_ERROR;
+    }
+
+    if (list->layout == LIST_LAYOUT_SOA) {
+        // moving arrays to their new offsets, data goes first because it is the farthest one
+        memmove(block + listDataOffset(newCapacity), block + listDataOffset(oldCapacity), oldCapacity * list->elemSize);
+        memmove(block + newCapacity * sizeof(int32_t), block + oldCapacity * sizeof(int32_t), oldCapacity * sizeof(int32_t));
     }
-    list->reserved *= 2;
+    listSetStorage(list, block, newCapacity);
+
+    // untouched region always ends at reserved, so new slots simply extend it
+    listPoison(list, list->reserved + 1, newReserved);
+    list->reserved = newReserved;
 
     LIST_ASSERT(list);
     return LIST_SUCCESS;
 }
 
-enum listStatus listCtor(cList_t *list, size_t elemSize, listPrintFunction_t sPrint) {
+/// @brief Grow list according to its growth policy, but at least to minReserved elements
+static enum listStatus listRealloc(cList_t *list, int64_t minReserved) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    int64_t reserved    = list->reserved;
+    int64_t newReserved = listNextCapacity(&list->growth, reserved, minReserved, LIST_MAX_RESERVED);
+
+    if (newReserved < minReserved || newReserved <= reserved) {
+        logPrint(L_ZERO, 1, "List [%p] can't grow to %lld elements, maximum capacity is %d\n",
+                            list, (long long) minReserved, LIST_MAX_RESERVED);
+        return LIST_SIZE_ERROR;
+    }
+
+    return listResize(list, (int32_t) newReserved);
+}
+
+enum listStatus listCtor(cList_t *list, size_t elemSize, listPrintFunction_t sPrint, enum listLayout layout) {
     MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
     logPrint(L_DEBUG, 0, "Constructing list [%p]\n", list);
 
     list->size     = 0;
     list->reserved = MIN_LIST_RESERVED;
     list->sPrint = sPrint;
-
-    list->elemSize = elemSize;
-    list->data     = calloc(MIN_LIST_RESERVED + 1, elemSize);
-
-    list->next     = (int32_t *) calloc(MIN_LIST_RESERVED + 1, sizeof(int32_t));
-    list->prev     = (int32_t *) calloc(MIN_LIST_RESERVED + 1, sizeof(int32_t));
+    list->growth = LIST_DEFAULT_GROWTH;
+    list->verifyLevel   = LIST_VERIFY_FULL;
+    list->verifyPeriod  = 0;
+    list->verifyCounter = 0;
+    list->index = NULL;
+    list->mapping     = NULL;
+    list->mappingSize = 0;
+    list->shared      = NULL;
+    list->journal     = NULL;
+    list->generation  = 0;
+    listSetLayout(list, elemSize, layout);
+
+    char *block = (char *) calloc(listStorageSize(list, MIN_LIST_RESERVED + 1), 1);
+    if (!block) {
+        logPrint(L_ZERO, 1, "Allocation of cList_t[%p] storage failed\n", list);
+        return LIST_MEMORY_ERROR;
+    }
+    listSetStorage(list, block, MIN_LIST_RESERVED + 1);
 
     //first element is reserved, it points to itself
 
     //next stores two sequences:
     //1. indexes of data elements
     //2. indexes of free elements
-    for (int32_t idx = 1; idx <= list->reserved; idx++) {
-        list->next[idx] = idx + 1; //filling free sequence
-        list->prev[idx] = -1;
-        memcpy((char *)list->data + elemSize * idx, &LIST_POISON, elemSize);
-    }
-    memcpy(list->data, &LIST_POISON, elemSize);
-    list->next[list->reserved] = 0; // next(last) = 0
+    //slots that were never used aren't linked, they form untouched region [untouched, reserved]
+    listPoison(list, 0, list->reserved);
 
-    list->next[0] = 0;
-    list->prev[0] = 0;
-    list->free    = 1;
+    listNextOf(list, 0) = 0;
+    listPrevOf(list, 0) = 0;
+    list->free      = NULL_LIST_IT;
+    list->untouched = 1;
+    list->linearized = true;
 
     LIST_ASSERT(list);
 
@@ -102,34 +313,215 @@ enum listStatus listCtor(cList_t *list, size_t elemSize, listPrintFunction_t sPr
     return LIST_SUCCESS;
 }
 
+enum listStatus listReserve(cList_t *list, int32_t reserved) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+
+    if (reserved > LIST_MAX_RESERVED) {
+        logPrint(L_ZERO, 1, "Can't reserve %d elements in list [%p], maximum is %d\n",
+                            reserved, list, LIST_MAX_RESERVED);
+        return LIST_SIZE_ERROR;
+    }
+
+    return listResize(list, reserved);
+}
+
+enum listStatus listSetGrowthPolicy(cList_t *list, listGrowthPolicy_t policy) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    if (!(policy.factor >= 1) || policy.step < 0 || policy.maxStep < 0) {
+        logPrint(L_ZERO, 1, "Invalid growth policy for list [%p]: factor = %g, step = %d, maxStep = %d\n",
+                            list, policy.factor, policy.step, policy.maxStep);
+        return LIST_ERROR;
+    }
+
+    list->growth = policy;
+    return LIST_SUCCESS;
+}
+
+/// @brief Move live node from slot src to free slot dest, fixing links of its neighbours
+static void listMoveNode(cList_t *list, listIterator_t src, listIterator_t dest) {
+    int32_t nextElem = listNextOf(list, src),
+            prevElem = listPrevOf(list, src);
+
+    memcpy(listDataOf(list, dest), listDataOf(list, src), list->elemSize);
+    listNextOf(list, dest) = nextElem;
+    listPrevOf(list, dest) = prevElem;
+    listNextOf(list, prevElem) = dest;
+    listPrevOf(list, nextElem) = dest;
+
+    listPrevOf(list, src) = INVALID_LIST_IT;
+}
+
+enum listStatus listShrinkToFit(cList_t *list, listIterator_t *remap) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+
+    if (listMakeWritable(list) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
+
+    int32_t newReserved = (list->size > (int32_t) MIN_LIST_RESERVED) ? list->size : (int32_t) MIN_LIST_RESERVED;
+    logPrint(L_DEBUG, 0, "Shrinking list [%p]: %d -> %d\n", list, list->reserved, newReserved);
+
+    // untouched slots are marked as free ones, all free slots are relinked below anyway
+    for (int32_t idx = list->untouched; idx <= list->reserved; idx++)
+        listPrevOf(list, idx) = INVALID_LIST_IT;
+    list->untouched = list->reserved + 1;
+
+    if (remap) {
+        remap[0] = NULL_LIST_IT;
+        for (int32_t idx = 1; idx <= list->reserved; idx++)
+            remap[idx] = (listPrevOf(list, idx) == INVALID_LIST_IT) ? INVALID_LIST_IT : idx;
+    }
+
+    // moving live nodes from slots above newReserved into free slots below it
+    int32_t dest = 1;
+    for (int32_t src = newReserved + 1; src <= list->reserved; src++) {
+        if (listPrevOf(list, src) == INVALID_LIST_IT)
+            continue;
+        while (listPrevOf(list, dest) != INVALID_LIST_IT)
+            dest++;
+
+        listMoveNode(list, src, dest);
+        if (remap) remap[src] = dest;
+    }
+
+    // all free slots are rebuilt as one sequence, in ascending order
+    list->free = NULL_LIST_IT;
+    for (int32_t idx = newReserved; idx >= 1; idx--) {
+        if (listPrevOf(list, idx) != INVALID_LIST_IT)
+            continue;
+        listNextOf(list, idx) = list->free;
+        list->free = idx;
+    }
+    list->untouched = newReserved + 1;
+
+    if (list->journal)
+        listJournalOperation(list, LIST_JOURNAL_SHRINK, NULL_LIST_IT, NULL_LIST_IT, NULL_LIST_IT);
+    if (newReserved == list->reserved)
+        return LIST_SUCCESS;
+
+    size_t oldCapacity = (size_t) list->reserved + 1,
+           newCapacity = (size_t) newReserved + 1;
+    char *block = (char *) list->next;
+    if (list->layout == LIST_LAYOUT_SOA) {
+        // moving arrays to their new offsets, prev goes first because it is the nearest one
+        memmove(block + newCapacity * sizeof(int32_t), block + oldCapacity * sizeof(int32_t), newCapacity * sizeof(int32_t));
+        memmove(block + listDataOffset(newCapacity), block + listDataOffset(oldCapacity), newCapacity * list->elemSize);
+    }
+
+    char *newBlock = listReallocStorage(list, listStorageSize(list, oldCapacity), listStorageSize(list, newCapacity));
+    // shrinking realloc failure leaves old block, which is still large enough
+    listSetStorage(list, newBlock ? newBlock : block, newCapacity);
+    list->reserved = newReserved;
+
+    // elements moved to lower slots, index keeps its memory and is refilled
+    if (list->index)
+        listIndexRebuild(list);
+
+    LIST_ASSERT(list);
+    return LIST_SUCCESS;
+}
+
 enum listStatus listDtor(cList_t *list) {
     MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
     LIST_ASSERT(list);
     logPrint(L_DEBUG, 0, "Destructing list [%p]\n", list);
-    free(list->data); list->data = NULL;
-    free(list->next); list->next = NULL;
-    free(list->prev); list->prev = NULL;
+    listDisableIndex(list);
+    listJournalDetach(list);
+    // next is the beginning of storage block
+    listReleaseStorage(list);
+    list->next = NULL;
+    list->prev = NULL;
+    list->data = NULL;
 
     logPrint(L_DEBUG, 0, "Destructed list [%p] successfully\n", list);
     return LIST_SUCCESS;
 }
 
+enum listStatus listClone(cList_t *dst, const cList_t *src) {
+    MY_ASSERT(dst, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(src, exit(LIST_NULL_PTR_ERROR));
+    logPrint(L_DEBUG, 0, "Cloning list [%p] to [%p]\n", src, dst);
+
+    size_t capacity = (size_t) src->reserved + 1,
+           size     = listStorageSize(src, capacity);
+    char *block = (char *) malloc(size);
+    if (!block) {
+        logPrint(L_ZERO, 1, "Allocation of cList_t[%p] storage failed\n", dst);
+        return LIST_MEMORY_ERROR;
+    }
+    // untouched region is copied too, so slots and free sequence stay the same
+    memcpy(block, src->next, size);
+
+    *dst = *src;
+    dst->index       = NULL;
+    dst->journal     = NULL;
+    dst->shared      = NULL;
+    dst->mapping     = NULL;
+    dst->mappingSize = 0;
+    dst->verifyCounter = 0;
+    listSetStorage(dst, block, capacity);
+
+    if (src->index && listEnableIndex(dst) != LIST_SUCCESS) {
+        listDtor(dst);
+        return LIST_MEMORY_ERROR;
+    }
+
+    LIST_ASSERT(dst);
+    return LIST_SUCCESS;
+}
+
+enum listStatus listSnapshot(cList_t *list, cList_t *snap) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(snap, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+    logPrint(L_DEBUG, 0, "Taking snapshot [%p] of list [%p]\n", snap, list);
+
+    // ownership of block moves from list to share record
+    if (!list->shared) {
+        listStorageShare_t *share = new (std::nothrow) listStorageShare_t;
+        if (!share) {
+            logPrint(L_ZERO, 1, "Allocation of storage share of list [%p] failed\n", list);
+            return LIST_MEMORY_ERROR;
+        }
+        share->refs.store(1, std::memory_order_relaxed);
+        share->block       = (char *) list->next;
+        share->mapping     = list->mapping;
+        share->mappingSize = list->mappingSize;
+        list->shared      = share;
+        list->mapping     = NULL;
+        list->mappingSize = 0;
+    }
+    list->shared->refs.fetch_add(1, std::memory_order_relaxed);
+
+    *snap = *list;
+    snap->index   = NULL;
+    snap->journal = NULL;
+    snap->verifyCounter = 0;
+    return LIST_SUCCESS;
+}
+
 enum listStatus listClear(cList_t *list) {
     MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
     LIST_ASSERT(list);
     logPrint(L_DEBUG, 0, "Clearing list [%p]\n", list);
+    // contents are discarded, so block shared with snapshots is replaced instead of being copied
+    if (!listReclaimStorage(list) && listDetachStorage(list) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
 
+    // all slots become untouched, so clearing doesn't depend on capacity
     list->size = 0;
-    list->next[0] = 0;
-    list->prev[0] = 0;
-    list->free = 1;
-    for (int32_t idx = 1; idx <= list->reserved; idx++) {
-        list->next[idx] = idx + 1; //filling free sequence
-        list->prev[idx] = -1;
-        memcpy((char *)list->data + list->elemSize * idx, &LIST_POISON, list->elemSize);
-    }
-    memcpy(list->data, &LIST_POISON, list->elemSize);
-    list->next[list->reserved] = 0;
+    listNextOf(list, 0) = 0;
+    listPrevOf(list, 0) = 0;
+    list->free      = NULL_LIST_IT;
+    list->untouched = 1;
+    list->linearized = true;
+    listPoison(list, 1, list->reserved);
+    if (list->index)
+        listIndexClear(list);
+    if (list->journal)
+        listJournalOperation(list, LIST_JOURNAL_CLEAR, NULL_LIST_IT, NULL_LIST_IT, NULL_LIST_IT);
 
     LIST_ASSERT(list);
     logPrint(L_DEBUG, 0, "Cleared list [%p]\n", list);
@@ -140,14 +532,14 @@ listIterator_t  listFront(cList_t *list) {
     MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
 
-    return (listIterator_t) list->next[0];
+    return (listIterator_t) listNextOf(list, 0);
 }
 
 listIterator_t  listBack(cList_t *list) {
     MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
 
-    return (listIterator_t) list->prev[0];
+    return (listIterator_t) listPrevOf(list, 0);
 }
 
 listIterator_t  listNext(cList_t *list, listIterator_t iter) {
@@ -162,7 +554,7 @@ listIterator_t  listNext(cList_t *list, listIterator_t iter) {
         return (listIterator_t) INVALID_LIST_IT;
     }
 
-    return list->next[iter];
+    return listNextOf(list, iter);
 }
 
 listIterator_t  listPrev(cList_t *list, listIterator_t iter) {
@@ -177,7 +569,7 @@ listIterator_t  listPrev(cList_t *list, listIterator_t iter) {
         return (listIterator_t) INVALID_LIST_IT;
     }
 
-    return list->prev[iter];
+    return listPrevOf(list, iter);
 }
 
 listIterator_t  listPushFront(cList_t *list, const void *elem) {
@@ -189,7 +581,7 @@ listIterator_t  listPushFront(cList_t *list, const void *elem) {
     listInsertAfter(list, 0, elem);
 
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
-    return list->next[0];
+    return listNextOf(list, 0);
 }
 
 listIterator_t  listPushBack(cList_t *list, const void *elem) {
@@ -198,10 +590,10 @@ listIterator_t  listPushBack(cList_t *list, const void *elem) {
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
 
     logPrint(L_EXTRA, 0, "Pushing element[%p] to back of list[%p]\n", elem, list);
-    listInsertAfter(list, list->prev[0], elem);
+    listInsertAfter(list, listPrevOf(list, 0), elem);
 
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
-    return list->prev[0];
+    return listPrevOf(list, 0);
 }
 
 listIterator_t listPopFront(cList_t *list) {
@@ -209,12 +601,12 @@ listIterator_t listPopFront(cList_t *list) {
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
 
     logPrint(L_EXTRA, 0, "Popping element at front of list[%p]\n", list);
-    if (listRemove(list, list->next[0]) != LIST_SUCCESS) {
+    if (listRemove(list, listNextOf(list, 0)) != LIST_SUCCESS) {
         return INVALID_LIST_IT;
     }
 
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
-    return list->next[0];
+    return listNextOf(list, 0);
 }
 
 listIterator_t listPopBack(cList_t *list) {
@@ -222,12 +614,12 @@ listIterator_t listPopBack(cList_t *list) {
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
 
     logPrint(L_EXTRA, 0, "Popping element at back of list[%p]\n", list);
-    if (listRemove(list, list->prev[0]) != LIST_SUCCESS) {
+    if (listRemove(list, listPrevOf(list, 0)) != LIST_SUCCESS) {
         return INVALID_LIST_IT;
     }
 
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
-    return list->prev[0];
+    return listPrevOf(list, 0);
 }
 
 enum listStatus listRemove(cList_t *list, listIterator_t iter) {
@@ -247,37 +639,168 @@ enum listStatus listRemove(cList_t *list, listIterator_t iter) {
         logPrint(L_ZERO, 1, "Attempt to pop element from empty list[%p]\n", list);
         return LIST_ERROR;
     }
+    if (iter == NULL_LIST_IT || listSlotIsFree(list, iter)) {
+        logPrint(L_DEBUG, 0, "Attempt to remove free slot %d of list[%p]\n", iter, list);
+        return LIST_ERROR;
+    }
+    if (listMakeWritable(list) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
+
+    // freed tale slot becomes head of free tail, so order is kept
+    if (iter != listPrevOf(list, 0))
+        list->linearized = false;
 
-    memcpy((char *)list->data + iter * list->elemSize, &LIST_POISON, list->elemSize);
-    int32_t nextElem = list->next[iter],
-            prevElem = list->prev[iter];
+    if (list->index)
+        listIndexRemove(list, iter);
+    listPoison(list, iter, iter);
+    int32_t nextElem = listNextOf(list, iter),
+            prevElem = listPrevOf(list, iter);
 
-    list->next[prevElem] = nextElem;
-    list->prev[nextElem] = prevElem;
+    listNextOf(list, prevElem) = nextElem;
+    listPrevOf(list, nextElem) = prevElem;
 
-    list->prev[iter] = INVALID_LIST_IT;
-    list->next[iter] = list->free;
+    listPrevOf(list, iter) = INVALID_LIST_IT;
+    listNextOf(list, iter) = list->free;
     list->free = iter;
 
     list->size--;
+    if (list->journal)
+        listJournalRemove(list, iter, iter);
 
-    LIST_ASSERT(list);
+    LIST_ASSERT_NODE(list, prevElem);
     return LIST_SUCCESS;
 }
 
+enum listStatus listRemoveRange(cList_t *list, listIterator_t first, listIterator_t last) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+
+    if (first == NULL_LIST_IT || checkIfInvalidIterator(list, first) || listSlotIsFree(list, first) ||
+        last  == NULL_LIST_IT || checkIfInvalidIterator(list, last)  || listSlotIsFree(list, last)) {
+        logPrint(L_DEBUG, 0, "Invalid range [%d, %d] passed in listRemoveRange\n"
+                             "For list[%p] maximum iterator is %d\n",
+                             first, last, list, list->reserved);
+        return LIST_ERROR;
+    }
+
+    logPrint(L_EXTRA, 0, "Removing elements [%d, %d] of list[%p]\n", first, last, list);
+
+    // range is checked before anything is changed
+    int32_t count = 1;
+    for (listIterator_t iter = first; iter != last; iter = listNextOf(list, iter), count++) {
+        if (listNextOf(list, iter) == NULL_LIST_IT) {
+            logPrint(L_DEBUG, 0, "Element %d doesn't follow %d in list[%p]\n", last, first, list);
+            return LIST_ERROR;
+        }
+    }
+
+    if (listMakeWritable(list) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
+
+    // freed tale run becomes head of free tail, so order is kept
+    if (last != listPrevOf(list, 0))
+        list->linearized = false;
+
+    int32_t prevElem = listPrevOf(list, first),
+            nextElem = listNextOf(list, last);
+    listNextOf(list, prevElem) = nextElem;
+    listPrevOf(list, nextElem) = prevElem;
+
+    for (listIterator_t iter = first; iter != nextElem; iter = listNextOf(list, iter)) {
+        if (list->index)
+            listIndexRemove(list, iter);
+        listPrevOf(list, iter) = INVALID_LIST_IT;
+        listPoison(list, iter, iter);
+    }
+
+    // whole run is already linked by next, so it is spliced into free sequence at once
+    listNextOf(list, last) = list->free;
+    list->free = first;
+
+    list->size -= count;
+    if (list->journal)
+        listJournalRemove(list, first, last);
+
+    LIST_ASSERT_NODE(list, prevElem);
+    return LIST_SUCCESS;
+}
 
 listIterator_t listFind(cList_t *list, const void *elem) {
     MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
     MY_ASSERT(elem, exit(LIST_NULL_PTR_ERROR));
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
 
-    listIterator_t iter = list->next[0];
-    while (iter != NULL_LIST_IT && memcmp(listGet(list, iter), elem, list->elemSize) != 0)
-        iter = listNext(list, iter);
+    if (list->index) {
+        bool duplicates = false;
+        listIterator_t found = listIndexLookup(list, elem, &duplicates);
+        if (!duplicates)
+            return found;
+    }
+
+    // list is verified once above, so walking arrays directly
+    listIterator_t iter = listNextOf(list, 0);
+    while (iter != NULL_LIST_IT && memcmp(listDataOf(list, iter), elem, list->elemSize) != 0)
+        iter = listNextOf(list, iter);
 
     return (iter == NULL_LIST_IT) ? INVALID_LIST_IT : iter;
 }
 
+listIterator_t listAt(cList_t *list, int32_t position) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
+
+    if (position < 0 || position >= list->size) {
+        logPrint(L_DEBUG, 0, "Position %d is out of range in listAt, list[%p] size is %d\n",
+                             position, list, list->size);
+        return INVALID_LIST_IT;
+    }
+
+    if (list->linearized)
+        return position + 1;
+
+    // walking from the nearest end
+    listIterator_t iter = NULL_LIST_IT;
+    if (position < list->size / 2) {
+        iter = listNextOf(list, 0);
+        for (int32_t step = 0; step < position; step++)
+            iter = listNextOf(list, iter);
+    } else {
+        iter = listPrevOf(list, 0);
+        for (int32_t step = list->size - 1; step > position; step--)
+            iter = listPrevOf(list, iter);
+    }
+    return iter;
+}
+
+int32_t listIndexOf(cList_t *list, listIterator_t iter) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    LIST_CUSTOM_ASSERT(list, -1);
+
+    if (iter == NULL_LIST_IT || checkIfInvalidIterator(list, iter) || listSlotIsFree(list, iter)) {
+        logPrint(L_DEBUG, 0, "Invalid listIterator_t passed in listIndexOf: %d\n"
+                             "For list[%p] maximum iterator is %d\n",
+                             iter, list, list->reserved);
+        return -1;
+    }
+
+    if (list->linearized)
+        return iter - 1;
+
+    int32_t position = 0;
+    for (listIterator_t cur = listPrevOf(list, iter); cur != NULL_LIST_IT; cur = listPrevOf(list, cur))
+        position++;
+    return position;
+}
+
+listCursor_t listCursorBegin(cList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    listCursor_t cursor = {list->next, list->linkStride, (char *) list->data, list->nodeSize, NULL_LIST_IT};
+    LIST_CUSTOM_ASSERT(list, cursor);
+
+    cursor.iter = listNextOf(list, 0);
+    return cursor;
+}
+
 /// @brief insert After iterator, return iterator to inserted elem
 listIterator_t listInsertAfter(cList_t *list, listIterator_t iter, const void *elem) {
     MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
@@ -293,23 +816,110 @@ listIterator_t listInsertAfter(cList_t *list, listIterator_t iter, const void *e
         return INVALID_LIST_IT;
     }
 
-    if (list->free == NULL_LIST_IT)
-        listRealloc(list);
+    if (list->size == list->reserved && listRealloc(list, list->reserved + 1) != LIST_SUCCESS)
+        return INVALID_LIST_IT;
+    if (listMakeWritable(list) != LIST_SUCCESS)
+        return INVALID_LIST_IT;
+
+    // in linearized list first free slot follows tale
+    if (iter != listPrevOf(list, 0))
+        list->linearized = false;
 
-    int32_t newElem = list->free;
-    list->free = list->next[list->free];
+    int32_t newElem = listTakeFree(list);
 
-    list->prev[newElem] = iter;
-    list->next[newElem] = list->next[iter];
-    list->prev[list->next[iter]] = newElem;
-    list->next[iter] = newElem;
+    listPrevOf(list, newElem) = iter;
+    listNextOf(list, newElem) = listNextOf(list, iter);
+    listPrevOf(list, listNextOf(list, iter)) = newElem;
+    listNextOf(list, iter) = newElem;
 
     list->size++;
 
-    memcpy(listGet(list, newElem), elem, list->elemSize);
+    memcpy(listDataOf(list, newElem), elem, list->elemSize);
+    if (list->index)
+        listIndexInsert(list, newElem);
+    if (list->journal)
+        listJournalInsert(list, iter, newElem, 1);
 
+    LIST_CUSTOM_ASSERT_NODE(list, newElem, INVALID_LIST_IT);
+    return listNextOf(list, iter);
+}
+
+listIterator_t listInsertRangeAfter(cList_t *list, listIterator_t iter, const void *elems, size_t count) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(elems || count == 0, exit(LIST_NULL_PTR_ERROR));
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
-    return list->next[iter];
+
+    logPrint(L_EXTRA, 0, "Inserting %zu elems[%p] in list[%p] after [%d] iterator\n", count, elems, list, iter);
+
+    if (checkIfInvalidIterator(list, iter) || (iter != NULL_LIST_IT && listSlotIsFree(list, iter))) {
+        logPrint(L_DEBUG, 0, "Invalid listIterator_t passed in listInsertRangeAfter: %d\n"
+                             "For list[%p] maximum iterator is %d\n",
+                             iter, list, list->reserved);
+        return INVALID_LIST_IT;
+    }
+    if (count == 0)
+        return NULL_LIST_IT;
+
+    int64_t newSize = (int64_t) list->size + (int64_t) count;
+    if (newSize > list->reserved && listRealloc(list, newSize) != LIST_SUCCESS)
+        return INVALID_LIST_IT;
+    if (listMakeWritable(list) != LIST_SUCCESS)
+        return INVALID_LIST_IT;
+
+    // in linearized list free slots after tale are taken in ascending order
+    if (iter != listPrevOf(list, 0))
+        list->linearized = false;
+
+    // taking free slots one by one, payload is copied by runs of adjacent slots
+    const char *src = (const char *) elems;
+    bool contiguousData = (list->layout == LIST_LAYOUT_SOA);
+    listIterator_t first = NULL_LIST_IT,
+                   last  = iter,
+                   runStart = NULL_LIST_IT;
+    size_t runLength = 0;
+    for (size_t idx = 0; idx < count; idx++) {
+        listIterator_t newElem = listTakeFree(list);
+        if (idx == 0)
+            first = runStart = newElem;
+
+        if (!contiguousData)
+            memcpy(listDataOf(list, newElem), src + idx * list->elemSize, list->elemSize);
+        else if (newElem != runStart + (int32_t) runLength) {
+            memcpy(listDataOf(list, runStart), src + (idx - runLength) * list->elemSize, runLength * list->elemSize);
+            runStart  = newElem;
+            runLength = 0;
+        }
+        runLength++;
+
+        listPrevOf(list, newElem) = last;
+        if (last != iter)
+            listNextOf(list, last) = newElem;
+        last = newElem;
+    }
+    if (contiguousData)
+        memcpy(listDataOf(list, runStart), src + (count - runLength) * list->elemSize, runLength * list->elemSize);
+
+    // splicing whole run after iter
+    listNextOf(list, last) = listNextOf(list, iter);
+    listPrevOf(list, listNextOf(list, iter)) = last;
+    listNextOf(list, iter) = first;
+
+    list->size = (int32_t) newSize;
+
+    if (list->index)
+        for (listIterator_t newElem = first; newElem != listNextOf(list, last); newElem = listNextOf(list, newElem))
+            listIndexInsert(list, newElem);
+    if (list->journal)
+        listJournalInsert(list, iter, first, (int32_t) count);
+
+    LIST_CUSTOM_ASSERT_NODE(list, first, INVALID_LIST_IT);
+    LIST_CUSTOM_ASSERT_NODE(list, last, INVALID_LIST_IT);
+    return first;
+}
+
+listIterator_t listPushBackBulk(cList_t *list, const void *elems, size_t count) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    return listInsertRangeAfter(list, listPrevOf(list, 0), elems, count);
 }
 
 /// @brief insert Before iterator, return iterator to inserted elem
@@ -318,7 +928,7 @@ listIterator_t listInsertBefore(cList_t *list, listIterator_t iter, const void *
     MY_ASSERT(elem, exit(LIST_NULL_PTR_ERROR));
     LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
 
-    return listInsertAfter(list, list->prev[iter], elem);
+    return listInsertAfter(list, listPrevOf(list, iter), elem);
 }
 
 void *listGet(cList_t *list, listIterator_t iter) {
@@ -333,15 +943,596 @@ void *listGet(cList_t *list, listIterator_t iter) {
         return NULL;
     }
 
-    if (list->prev[iter] == INVALID_LIST_IT) {
+    if (listSlotIsFree(list, iter)) {
         // if previous element is not defined, iter's empty element
         return NULL;
     }
 
-    return (void *) ( (char *) list->data + list->elemSize * iter );
+    return listDataOf(list, iter);
 }
 
-enum listStatus listVerify(cList_t *list) {
+void *listGetMut(cList_t *list, listIterator_t iter) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    // block is copied only for valid element, and the copy moves payload
+    if (!listGet(list, iter) || listMakeWritable(list) != LIST_SUCCESS)
+        return NULL;
+    return listDataOf(list, iter);
+}
+
+/*! @brief Move payloads so that element k of next sequence sits in slot k+1
+    Only next links of elements and prev = INVALID_LIST_IT of free slots are used,
+    prev links of elements may be stale, all links are rebuilt
+!*/
+static void listPlaceInOrder(cList_t *list) {
+    // prev array temporarily stores destination slot of every element
+    int32_t rank = 1;
+    for (listIterator_t iter = listNextOf(list, 0); iter != NULL_LIST_IT; ) {
+        listIterator_t nextIter = listNextOf(list, iter);
+        listPrevOf(list, iter) = rank++;
+        iter = nextIter;
+    }
+    // untouched region has no payloads and stays in place
+    for (int32_t idx = 1; idx < list->untouched; idx++)
+        if (listPrevOf(list, idx) == INVALID_LIST_IT)
+            listPrevOf(list, idx) = rank++;
+
+    // applying permutation cycle by cycle, every swap puts one element in place
+    for (int32_t idx = 1; idx < list->untouched; idx++) {
+        while (listPrevOf(list, idx) != idx) {
+            int32_t dest = listPrevOf(list, idx);
+            swap(listDataOf(list, idx), listDataOf(list, dest), list->elemSize);
+            listPrevOf(list, idx)  = listPrevOf(list, dest);
+            listPrevOf(list, dest) = dest;
+        }
+    }
+
+    for (int32_t idx = 1; idx <= list->size; idx++) {
+        listNextOf(list, idx) = idx + 1;
+        listPrevOf(list, idx) = idx - 1;
+    }
+    if (list->size > 0)
+        listNextOf(list, list->size) = NULL_LIST_IT;
+    listNextOf(list, 0) = (list->size > 0) ? 1 : NULL_LIST_IT;
+    listPrevOf(list, 0) = list->size;
+
+    // all free slots are right after elements now
+    list->free      = NULL_LIST_IT;
+    list->untouched = list->size + 1;
+
+    list->linearized = true;
+
+    if (list->index)
+        listIndexRebuild(list);
+}
+
+enum listStatus listLinearize(cList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+    logPrint(L_DEBUG, 0, "Linearizing list [%p]\n", list);
+
+    if (list->linearized)
+        return LIST_SUCCESS;
+    if (listMakeWritable(list) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
+
+    listPlaceInOrder(list);
+    if (list->journal)
+        listJournalOperation(list, LIST_JOURNAL_LINEARIZE, NULL_LIST_IT, NULL_LIST_IT, NULL_LIST_IT);
+
+    LIST_ASSERT(list);
+    return LIST_SUCCESS;
+}
+
+/*! @brief Stable bottom-up merge sort of next sequence, payloads aren't moved
+    Runs of width 1, 2, 4... are merged by relinking, O(n log n) compares and O(1) memory
+    Only next links are valid after call, NULL element is used as head of merged sequence
+!*/
+static void listMergeSortLinks(cList_t *list, listCompare_t cmp) {
+    for (int64_t width = 1; ; width *= 2) {
+        listIterator_t left = listNextOf(list, 0),
+                       tale = 0;
+        int32_t merges = 0;
+
+        while (left != NULL_LIST_IT) {
+            merges++;
+            listIterator_t right = left;
+            int64_t leftSize = 0, rightSize = width;
+            for (; leftSize < width && right != NULL_LIST_IT; leftSize++)
+                right = listNextOf(list, right);
+
+            while (leftSize > 0 || (rightSize > 0 && right != NULL_LIST_IT)) {
+                listIterator_t taken = NULL_LIST_IT;
+                // taking from left run on equal elements keeps sort stable
+                if (leftSize > 0 && (rightSize == 0 || right == NULL_LIST_IT ||
+                                     cmp(listDataOf(list, left), listDataOf(list, right)) <= 0)) {
+                    taken = left;
+                    left  = listNextOf(list, left);
+                    leftSize--;
+                } else {
+                    taken = right;
+                    right = listNextOf(list, right);
+                    rightSize--;
+                }
+                listNextOf(list, tale) = taken;
+                tale = taken;
+            }
+            left = right;
+        }
+        listNextOf(list, tale) = NULL_LIST_IT;
+
+        if (merges <= 1)
+            return;
+    }
+}
+
+/// @brief Restore prev links after next sequence is relinked
+static void listRestorePrevLinks(cList_t *list) {
+    // list stays linearized only if new order matches slots
+    bool inOrder = true;
+    int32_t rank = 1;
+    listIterator_t prevElem = NULL_LIST_IT;
+    for (listIterator_t iter = listNextOf(list, 0); iter != NULL_LIST_IT; iter = listNextOf(list, iter)) {
+        listPrevOf(list, iter) = prevElem;
+        inOrder = inOrder && (iter == rank++);
+        prevElem = iter;
+    }
+    listPrevOf(list, 0) = prevElem;
+    list->linearized = list->linearized && inOrder;
+}
+
+enum listStatus listSort(cList_t *list, listCompare_t cmp) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(cmp,  exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+    logPrint(L_DEBUG, 0, "Sorting list [%p]\n", list);
+    if (listMakeWritable(list) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
+
+    listMergeSortLinks(list, cmp);
+    listRestorePrevLinks(list);
+    if (list->journal)
+        listJournalOrder(list, LIST_JOURNAL_SORT);
+
+    LIST_ASSERT(list);
+    return LIST_SUCCESS;
+}
+
+enum listStatus listSortLinearize(cList_t *list, listCompare_t cmp) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(cmp,  exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+    logPrint(L_DEBUG, 0, "Sorting and linearizing list [%p]\n", list);
+    if (listMakeWritable(list) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
+
+    listMergeSortLinks(list, cmp);
+    // order is journaled before payloads are moved, replay moves them the same way
+    if (list->journal)
+        listJournalOrder(list, LIST_JOURNAL_SORT_LINEARIZE);
+    // placing pass rebuilds prev links itself, so they aren't restored after sort
+    listPlaceInOrder(list);
+
+    LIST_ASSERT(list);
+    return LIST_SUCCESS;
+}
+
+enum listStatus listApplyOrder(cList_t *list, const int32_t *order, int32_t count, bool linearize) {
+    MY_ASSERT(list,  exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(order || count == 0, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+
+    if (count != list->size)
+        return LIST_ERROR;
+
+    // every element must appear exactly once, links aren't touched until it's checked
+    bool *seen = (bool *) calloc((size_t) list->reserved + 1, sizeof(bool));
+    if (!seen)
+        return LIST_MEMORY_ERROR;
+    bool permutation = true;
+    for (int32_t idx = 0; idx < count && permutation; idx++) {
+        listIterator_t slot = order[idx];
+        permutation = slot != NULL_LIST_IT && !checkIfInvalidIterator(list, slot) &&
+                      !listSlotIsFree(list, slot) && !seen[slot];
+        if (permutation)
+            seen[slot] = true;
+    }
+    free(seen);
+    if (!permutation)
+        return LIST_ERROR;
+    if (listMakeWritable(list) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
+
+    listIterator_t tale = NULL_LIST_IT;
+    for (int32_t idx = 0; idx < count; idx++) {
+        listNextOf(list, tale) = order[idx];
+        tale = order[idx];
+    }
+    listNextOf(list, tale) = NULL_LIST_IT;
+
+    if (linearize)
+        listPlaceInOrder(list);
+    else
+        listRestorePrevLinks(list);
+
+    LIST_ASSERT(list);
+    return LIST_SUCCESS;
+}
+
+/*! @brief Copy count elements of src starting from first after iter of dst, src != dst
+    Physically adjacent SoA payloads are copied by one listInsertRangeAfter
+    dst must be already writable with reserved capacity, so copying doesn't fail
+    @return Last inserted elem of dst, INVALID_LIST_IT if some run wasn't inserted, dst is unchanged then
+!*/
+static listIterator_t listCopyRangeAfter(cList_t *dst, listIterator_t iter,
+                                         cList_t *src, listIterator_t first, int32_t count) {
+    listIterator_t after = listNextOf(dst, iter);
+    bool contiguousData = (src->layout == LIST_LAYOUT_SOA);
+
+    listIterator_t runStart = first;
+    int32_t runLength = 0;
+    for (listIterator_t elem = first; count > 0; count--) {
+        listIterator_t nextElem = listNextOf(src, elem);
+        runLength++;
+        if (count == 1 || !contiguousData || nextElem != elem + 1) {
+            if (listInsertRangeAfter(dst, listPrevOf(dst, after), listDataOf(src, runStart),
+                                     (size_t) runLength) == INVALID_LIST_IT) {
+                // runs copied before are removed, so copy is all or nothing
+                if (listNextOf(dst, iter) != after)
+                    listRemoveRange(dst, listNextOf(dst, iter), listPrevOf(dst, after));
+                return INVALID_LIST_IT;
+            }
+            runStart  = nextElem;
+            runLength = 0;
+        }
+        elem = nextElem;
+    }
+    return listPrevOf(dst, after);
+}
+
+/// @brief Count elements [first, last], -1 if last doesn't follow first
+/// @param stop Element that must not be inside [first, last), NULL_LIST_IT if there is none
+static int32_t listCountRange(cList_t *list, listIterator_t first, listIterator_t last, listIterator_t stop) {
+    int32_t count = 1;
+    for (listIterator_t iter = first; iter != last; iter = listNextOf(list, iter), count++) {
+        if (listNextOf(list, iter) == NULL_LIST_IT || iter == stop)
+            return -1;
+    }
+    return count;
+}
+
+listIterator_t listSplice(cList_t *dst, listIterator_t pos, cList_t *src, listIterator_t first, listIterator_t last) {
+    MY_ASSERT(dst, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(src, exit(LIST_NULL_PTR_ERROR));
+    LIST_CUSTOM_ASSERT(dst, INVALID_LIST_IT);
+    LIST_CUSTOM_ASSERT(src, INVALID_LIST_IT);
+
+    if (checkIfInvalidIterator(dst, pos) || (pos != NULL_LIST_IT && listSlotIsFree(dst, pos)) ||
+        first == NULL_LIST_IT || checkIfInvalidIterator(src, first) || listSlotIsFree(src, first) ||
+        last  == NULL_LIST_IT || checkIfInvalidIterator(src, last)  || listSlotIsFree(src, last)) {
+        logPrint(L_DEBUG, 0, "Invalid range [%d, %d] or position %d passed in listSplice\n", first, last, pos);
+        return INVALID_LIST_IT;
+    }
+    if (dst->elemSize != src->elemSize) {
+        logPrint(L_ZERO, 1, "Can't splice list[%p] into list[%p]: element sizes %zu and %zu differ\n",
+                            src, dst, src->elemSize, dst->elemSize);
+        return INVALID_LIST_IT;
+    }
+
+    logPrint(L_EXTRA, 0, "Splicing elements [%d, %d] of list[%p] after [%d] of list[%p]\n", first, last, src, pos, dst);
+
+    // range is checked before anything is changed, position must not be inside of it
+    int32_t count = listCountRange(src, first, last, (src == dst) ? pos : NULL_LIST_IT);
+    if (count < 0) {
+        logPrint(L_DEBUG, 0, "Element %d doesn't follow %d in list[%p] or position %d is inside range\n",
+                             last, first, src, pos);
+        return INVALID_LIST_IT;
+    }
+
+    if (src == dst) {
+        // relinking inside one storage, payloads and iterators stay in place
+        if (pos == last || pos == listPrevOf(src, first))
+            return first;
+        if (listMakeWritable(src) != LIST_SUCCESS)
+            return INVALID_LIST_IT;
+
+        listIterator_t prevElem = listPrevOf(src, first),
+                       nextElem = listNextOf(src, last);
+        listNextOf(src, prevElem) = nextElem;
+        listPrevOf(src, nextElem) = prevElem;
+
+        listIterator_t after = listNextOf(src, pos);
+        listNextOf(src, pos)   = first;
+        listPrevOf(src, first) = pos;
+        listNextOf(src, last)  = after;
+        listPrevOf(src, after) = last;
+
+        src->linearized = false;
+        if (src->journal)
+            listJournalOperation(src, LIST_JOURNAL_MOVE, pos, first, last);
+
+        LIST_CUSTOM_ASSERT_NODE(src, first, INVALID_LIST_IT);
+        LIST_CUSTOM_ASSERT_NODE(src, last,  INVALID_LIST_IT);
+        return first;
+    }
+
+    // storages are independent, so payloads are copied and range is freed in src
+    int64_t newSize = (int64_t) dst->size + count;
+    if (newSize > dst->reserved && listRealloc(dst, newSize) != LIST_SUCCESS)
+        return INVALID_LIST_IT;
+    if (listMakeWritable(dst) != LIST_SUCCESS || listMakeWritable(src) != LIST_SUCCESS)
+        return INVALID_LIST_IT;
+
+    listIterator_t copyLast = listCopyRangeAfter(dst, pos, src, first, count);
+    if (copyLast == INVALID_LIST_IT)
+        return INVALID_LIST_IT;
+    // src elements are removed only when all of them are in dst, otherwise copies are dropped
+    if (listRemoveRange(src, first, last) != LIST_SUCCESS) {
+        listRemoveRange(dst, listNextOf(dst, pos), copyLast);
+        return INVALID_LIST_IT;
+    }
+
+    LIST_CUSTOM_ASSERT(dst, INVALID_LIST_IT);
+    LIST_CUSTOM_ASSERT(src, INVALID_LIST_IT);
+    return listNextOf(dst, pos);
+}
+
+enum listStatus listSplitAt(cList_t *list, listIterator_t iter, cList_t *out) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(out,  exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+
+    if (out == list || iter == NULL_LIST_IT || checkIfInvalidIterator(list, iter) || listSlotIsFree(list, iter)) {
+        logPrint(L_DEBUG, 0, "Invalid listIterator_t %d or output list passed in listSplitAt\n", iter);
+        return LIST_ERROR;
+    }
+
+    if (listSplice(out, listPrevOf(out, 0), list, iter, listPrevOf(list, 0)) == INVALID_LIST_IT)
+        return LIST_ERROR;
+    return LIST_SUCCESS;
+}
+
+enum listStatus listMerge(cList_t *dst, cList_t *src, listCompare_t cmp) {
+    MY_ASSERT(dst, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(src, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(cmp, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(dst);
+    LIST_ASSERT(src);
+
+    if (dst == src || dst->elemSize != src->elemSize) {
+        logPrint(L_ZERO, 1, "Can't merge list[%p] into list[%p]\n", src, dst);
+        return LIST_ERROR;
+    }
+    logPrint(L_DEBUG, 0, "Merging list[%p] into list[%p]\n", src, dst);
+
+    if (src->size == 0)
+        return LIST_SUCCESS;
+
+    // capacity is reserved and storages are made writable once, so merge either fails before changes or completes
+    int64_t newSize = (int64_t) dst->size + src->size;
+    if (newSize > dst->reserved && listRealloc(dst, newSize) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
+    if (listMakeWritable(dst) != LIST_SUCCESS || listMakeWritable(src) != LIST_SUCCESS)
+        return LIST_MEMORY_ERROR;
+
+    listIterator_t iter = NULL_LIST_IT,
+                   elem = listNextOf(src, 0);
+    while (elem != NULL_LIST_IT) {
+        // dst elements go first among equal ones, so merge is stable
+        listIterator_t after = listNextOf(dst, iter);
+        while (after != NULL_LIST_IT && cmp(listDataOf(dst, after), listDataOf(src, elem)) <= 0) {
+            iter  = after;
+            after = listNextOf(dst, after);
+        }
+
+        // run of src elements that go before after is copied at once
+        listIterator_t runStart = elem;
+        int32_t runLength = 0;
+        while (elem != NULL_LIST_IT &&
+               (after == NULL_LIST_IT || cmp(listDataOf(dst, after), listDataOf(src, elem)) > 0)) {
+            elem = listNextOf(src, elem);
+            runLength++;
+        }
+        iter = listCopyRangeAfter(dst, iter, src, runStart, runLength);
+        if (iter == INVALID_LIST_IT) {
+            logPrint(L_ZERO, 1, "Merging list[%p] into list[%p] failed, src is kept\n", src, dst);
+            return LIST_ERROR;
+        }
+    }
+
+    LIST_ASSERT(dst);
+    return listClear(src);
+}
+
+/// Identifies list file
+const char     LIST_FILE_MAGIC[8] = {'c', 'L', 'i', 's', 't', 'F', 'i', 'l'};
+/// Changes whenever header or storage block layout changes
+const uint32_t LIST_FILE_VERSION  = 2;
+/// Written in native byte order, file from machine with other one doesn't match it
+const uint32_t LIST_FILE_BYTE_ORDER = 0x01020304;
+/// Storage block starts at page boundary of file, so mapped arrays are aligned
+const size_t   LIST_FILE_HEADER_SIZE = 4096;
+
+typedef struct listFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t headerSize;    ///< Offset of storage block in file
+    uint64_t storageSize;   ///< Size of storage block for reserved + 1 slots
+    uint64_t elemSize;
+    uint64_t maxAlign;      ///< alignof(max_align_t), offset of data array in SoA block depends on it
+    uint32_t layout;
+    uint32_t linearized;
+    int32_t  size;
+    int32_t  reserved;
+    int32_t  free;
+    int32_t  untouched;
+    uint64_t generation;    ///< Checkpoint generation of list, matched against journal
+} listFileHeader_t;
+
+static_assert(sizeof(listFileHeader_t) <= LIST_FILE_HEADER_SIZE, "list file header doesn't fit its page");
+
+/// @brief fsync directory holding path, so rename of file in it is durable
+static bool listSyncDirectoryOf(const char *path) {
+    const char *slash = strrchr(path, '/');
+    size_t dirLen = slash ? (size_t) (slash - path) + 1 : 0;
+
+    char *dirPath = (char *) calloc(dirLen + sizeof("."), 1);
+    if (!dirPath)
+        return false;
+    memcpy(dirPath, path, dirLen);
+    if (dirLen == 0)
+        dirPath[0] = '.';
+
+    int fd = open(dirPath, O_RDONLY | O_DIRECTORY);
+    free(dirPath);
+    if (fd < 0)
+        return false;
+    bool synced = fsync(fd) == 0;
+    return (close(fd) == 0) && synced;
+}
+
+enum listStatus listSaveToFile(cList_t *list, const char *path) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(path, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+    logPrint(L_DEBUG, 0, "Saving list [%p] to %s\n", list, path);
+
+    listFileHeader_t header = {};
+    memcpy(header.magic, LIST_FILE_MAGIC, sizeof(header.magic));
+    header.version     = LIST_FILE_VERSION;
+    header.byteOrder   = LIST_FILE_BYTE_ORDER;
+    header.headerSize  = LIST_FILE_HEADER_SIZE;
+    header.storageSize = listStorageSize(list, (size_t) list->reserved + 1);
+    header.elemSize    = list->elemSize;
+    header.maxAlign    = alignof(max_align_t);
+    header.layout      = (uint32_t) list->layout;
+    header.linearized  = list->linearized;
+    header.size        = list->size;
+    header.reserved    = list->reserved;
+    header.free        = list->free;
+    header.untouched   = list->untouched;
+    header.generation  = list->generation;
+
+    // file is written beside target and renamed, so nobody maps half-written list
+    size_t pathLen = strlen(path);
+    char *tmpPath = (char *) calloc(pathLen + sizeof(".tmp"), 1);
+    if (!tmpPath)
+        return LIST_MEMORY_ERROR;
+    memcpy(tmpPath, path, pathLen);
+    memcpy(tmpPath + pathLen, ".tmp", sizeof(".tmp"));
+
+    FILE *file = fopen(tmpPath, "wb");
+    if (!file) {
+        logPrint(L_ZERO, 1, "Can't open %s to save list [%p]\n", tmpPath, list);
+        free(tmpPath);
+        return LIST_FILE_ERROR;
+    }
+
+    // gap between header and storage block is filled with zeros by seek
+    // data reaches disk before rename, rename reaches disk before return
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fseek(file, (long) LIST_FILE_HEADER_SIZE, SEEK_SET) == 0 &&
+                   fwrite(list->next, 1, header.storageSize, file) == header.storageSize &&
+                   fflush(file) == 0 && fsync(fileno(file)) == 0;
+    written = (fclose(file) == 0) && written;
+    if (written)
+        written = rename(tmpPath, path) == 0 && listSyncDirectoryOf(path);
+
+    if (!written) {
+        logPrint(L_ZERO, 1, "Writing list [%p] to %s failed\n", list, path);
+        remove(tmpPath);
+    }
+    free(tmpPath);
+    return written ? LIST_SUCCESS : LIST_FILE_ERROR;
+}
+
+/// @brief Check that header describes list this build can map, fileSize is size of whole file
+static bool listFileHeaderIsValid(const listFileHeader_t *header, size_t fileSize) {
+    if (memcmp(header->magic, LIST_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != LIST_FILE_VERSION || header->byteOrder != LIST_FILE_BYTE_ORDER ||
+        header->maxAlign != alignof(max_align_t))
+        return false;
+
+    if (header->layout != LIST_LAYOUT_SOA && header->layout != LIST_LAYOUT_AOS)
+        return false;
+    if (header->elemSize == 0 || header->reserved < (int32_t) MIN_LIST_RESERVED ||
+        header->reserved > LIST_MAX_RESERVED || header->size < 0 || header->size > header->reserved)
+        return false;
+    if (header->untouched < 1 || header->untouched > header->reserved + 1 ||
+        header->free < 0 || header->free > header->reserved)
+        return false;
+
+    return header->headerSize >= sizeof(listFileHeader_t) && header->headerSize % alignof(max_align_t) == 0 &&
+           header->headerSize <= fileSize && header->storageSize <= fileSize - header->headerSize;
+}
+
+enum listStatus listMapFile(cList_t *list, const char *path, listPrintFunction_t sPrint) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(path, exit(LIST_NULL_PTR_ERROR));
+    logPrint(L_DEBUG, 0, "Mapping list [%p] from %s\n", list, path);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        logPrint(L_ZERO, 1, "Can't open list file %s\n", path);
+        return LIST_FILE_ERROR;
+    }
+    struct stat fileStat = {};
+    if (fstat(fd, &fileStat) != 0 || (size_t) fileStat.st_size < sizeof(listFileHeader_t)) {
+        logPrint(L_ZERO, 1, "List file %s is too short\n", path);
+        close(fd);
+        return LIST_FILE_ERROR;
+    }
+
+    // private mapping: writes to list copy touched pages, file stays as it was saved
+    size_t fileSize = (size_t) fileStat.st_size;
+    void *mapping = mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        logPrint(L_ZERO, 1, "Can't map list file %s\n", path);
+        return LIST_FILE_ERROR;
+    }
+
+    listFileHeader_t header = {};
+    memcpy(&header, mapping, sizeof(header));
+    if (!listFileHeaderIsValid(&header, fileSize)) {
+        logPrint(L_ZERO, 1, "List file %s has wrong format or version\n", path);
+        munmap(mapping, fileSize);
+        return LIST_FILE_ERROR;
+    }
+
+    listSetLayout(list, header.elemSize, (enum listLayout) header.layout);
+    size_t capacity = (size_t) header.reserved + 1;
+    if (listStorageSize(list, capacity) != header.storageSize) {
+        logPrint(L_ZERO, 1, "Storage block of list file %s has wrong size\n", path);
+        munmap(mapping, fileSize);
+        return LIST_FILE_ERROR;
+    }
+
+    list->size       = header.size;
+    list->reserved   = header.reserved;
+    list->free       = header.free;
+    list->untouched  = header.untouched;
+    list->linearized = header.linearized;
+    list->sPrint     = sPrint;
+    list->growth     = LIST_DEFAULT_GROWTH;
+    list->verifyLevel   = LIST_VERIFY_FULL;
+    list->verifyPeriod  = 0;
+    list->verifyCounter = 0;
+    list->index       = NULL;
+    list->journal     = NULL;
+    list->generation  = header.generation;
+    list->shared      = NULL;
+    list->mapping     = mapping;
+    list->mappingSize = fileSize;
+    listSetStorage(list, (char *) mapping + header.headerSize, capacity);
+
+    LIST_ASSERT(list);
+    return LIST_SUCCESS;
+}
+
+/// @brief O(1) checks of sizes, storage and head, tale and free iterators
+static enum listStatus listVerifyHeader(cList_t *list) {
     MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
     /* CHECKING BASIC LOGIC*/
     if (list->reserved < 0) {
@@ -375,15 +1566,15 @@ enum listStatus listVerify(cList_t *list) {
     }
 
     /*CHECKING OBVIOUS HEAD, TALE AND FREE ERRORS*/
-    int32_t head = list->next[0],
-            tale = list->prev[0];
+    int32_t head = listNextOf(list, 0),
+            tale = listPrevOf(list, 0);
     if (checkIfInvalidIterator(list, head)){
         logPrint(L_ZERO, 1, "Head iterator in list [%p] is invalid: %ld\n", list, head);
         return LIST_HEAD_ERROR;
     }
-    if (list->prev[head] != 0) {
+    if (listPrevOf(list, head) != 0) {
         logPrint(L_ZERO, 1, "Head iterator in list [%p] is misplaced: prev[head] = %ld != 0\n",
-                 list, list->prev[head]);
+                 list, listPrevOf(list, head));
         return LIST_HEAD_ERROR;
     }
 
@@ -391,41 +1582,141 @@ enum listStatus listVerify(cList_t *list) {
         logPrint(L_ZERO, 1, "Tale iterator in list [%p] is invalid: %ld\n", list, tale);
         return LIST_TALE_ERROR;
     }
-    if (list->next[tale] != 0) {
+    if (listNextOf(list, tale) != 0) {
         logPrint(L_ZERO, 1, "Tale iterator in list [%p] is misplaced: next[tale] = %ld != 0\n",
-                 list, list->next[tale]);
+                 list, listNextOf(list, tale));
         return LIST_TALE_ERROR;
     }
 
-    if (checkIfInvalidIterator(list, list->free)) {
+    if (list->untouched < 1 || list->untouched > list->reserved + 1) {
+        logPrint(L_ZERO, 1, "Untouched region in list [%p] is invalid: [%d, %d]\n",
+                 list, list->untouched, list->reserved);
+        return LIST_FREE_ERROR;
+    }
+    if (checkIfInvalidIterator(list, list->free) || list->free >= list->untouched) {
         logPrint(L_ZERO, 1, "Free iterator in list [%p] is invalid: %ld\n", list, list->free);
         return LIST_FREE_ERROR;
     }
-    if (list->free != 0 && list->prev[list->free] != -1) {
+    if (list->free != 0 && listPrevOf(list, list->free) != -1) {
         logPrint(L_ZERO, 1, "Free iterator in list [%p] is misplaced: prev[free] = %ld != -1\n",
-                 list, list->prev[list->free]);
+                 list, listPrevOf(list, list->free));
         return LIST_FREE_ERROR;
     }
 
+    return LIST_SUCCESS;
+}
+
+/// @brief Check that node is linked with its neighbours both ways
+static enum listStatus listVerifyLinks(cList_t *list, listIterator_t iter) {
+    int32_t nextElem = listNextOf(list, iter),
+            prevElem = listPrevOf(list, iter);
+    if (checkIfInvalidIterator(list, nextElem) || listPrevOf(list, nextElem) != iter) {
+        logPrint(L_ZERO, 1, "Bad next link of node %d in list [%p]: next = %d\n", iter, list, nextElem);
+        return LIST_NEXT_LINK_ERROR;
+    }
+    if (checkIfInvalidIterator(list, prevElem) || listNextOf(list, prevElem) != iter) {
+        logPrint(L_ZERO, 1, "Bad prev link of node %d in list [%p]: prev = %d\n", iter, list, prevElem);
+        return LIST_PREV_LINK_ERROR;
+    }
+    return LIST_SUCCESS;
+}
+
+enum listStatus listVerifyLocal(cList_t *list, listIterator_t iter) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    enum listStatus status = listVerifyHeader(list);
+    if (status != LIST_SUCCESS || iter == NULL_LIST_IT)
+        return status;
+
+    if (checkIfInvalidIterator(list, iter) || listSlotIsFree(list, iter)) {
+        logPrint(L_ZERO, 1, "Node %d of list [%p] isn't an element\n", iter, list);
+        return LIST_ERROR;
+    }
+
+    // node itself and both of its neighbours
+    status = listVerifyLinks(list, iter);
+    if (status == LIST_SUCCESS && listNextOf(list, iter) != NULL_LIST_IT)
+        status = listVerifyLinks(list, listNextOf(list, iter));
+    if (status == LIST_SUCCESS && listPrevOf(list, iter) != NULL_LIST_IT)
+        status = listVerifyLinks(list, listPrevOf(list, iter));
+    return status;
+}
+
+enum listStatus listSetVerifyLevel(cList_t *list, enum listVerifyLevel level, uint32_t period) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    if (level == LIST_VERIFY_SAMPLED && period == 0) {
+        logPrint(L_ZERO, 1, "Sampled verification of list [%p] needs positive period\n", list);
+        return LIST_ERROR;
+    }
+
+    list->verifyLevel   = level;
+    list->verifyPeriod  = period;
+    list->verifyCounter = 0;
+    return LIST_SUCCESS;
+}
+
+enum listStatus listCheck(cList_t *list, listIterator_t touched) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    switch (list->verifyLevel) {
+    case LIST_VERIFY_OFF:
+        return LIST_SUCCESS;
+    case LIST_VERIFY_LOCAL:
+        return listVerifyLocal(list, touched);
+    case LIST_VERIFY_SAMPLED:
+        if (++list->verifyCounter >= list->verifyPeriod) {
+            list->verifyCounter = 0;
+            return listVerify(list);
+        }
+        return listVerifyLocal(list, touched);
+    case LIST_VERIFY_FULL:
+        return listVerify(list);
+    default:
+        logPrint(L_ZERO, 1, "Unknown verification level of list [%p]: %d\n", list, list->verifyLevel);
+        return LIST_ERROR;
+    }
+}
+
+enum listStatus listVerify(cList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    enum listStatus status = listVerifyHeader(list);
+    if (status != LIST_SUCCESS)
+        return status;
+
+    int32_t head = listNextOf(list, 0),
+            tale = listPrevOf(list, 0);
+
     /*CHECKING NEXT, FREE AND PREV ON LINKING ERRORS (FULL ELEMENT COVERAGE AND ABSENCE OF LOOPS)*/
     int32_t visitedCounter = 0;
     listIterator_t iter = head;
     //list->reserved + 5 to be sure that verifier has found loop
-    for (;iter != NULL_LIST_IT && visitedCounter < list->reserved + 5;iter = list->next[iter]) {
-        if (list->next[iter] < 0 || list->next[iter] > list->reserved) {
+    for (;iter != NULL_LIST_IT && visitedCounter < list->reserved + 5;iter = listNextOf(list, iter)) {
+        if (listNextOf(list, iter) < 0 || listNextOf(list, iter) > list->reserved) {
             logPrint(L_ZERO, 1, "Bad iterator in next sequence in list [%p]:\n"
                                 "\tnext[iter] = %d\n"
                                 "\tmaxIter = capacity = %d\n",
-                                list, list->next[iter], list->reserved);
+                                list, listNextOf(list, iter), list->reserved);
             return LIST_NEXT_LINK_ERROR;
         }
-        if (list->prev[list->next[iter]] != iter) {
+        if (listPrevOf(list, listNextOf(list, iter)) != iter) {
             logPrint(L_ZERO, 1, "prev[next[iter]] != iter in list [%p]:\n"
                                 "\tnext[%d] = %d\n"
                                 "\tprev[next[iter]] = %d != %d\n",
-                                list, iter, list->next[iter], list->prev[list->next[iter]], iter);
+                                list, iter, listNextOf(list, iter), listPrevOf(list, listNextOf(list, iter)), iter);
+            return LIST_NEXT_LINK_ERROR;
+        }
+        if (iter >= list->untouched) {
+            logPrint(L_ZERO, 1, "Element %d of list [%p] is in untouched region [%d, %d]\n",
+                                iter, list, list->untouched, list->reserved);
             return LIST_NEXT_LINK_ERROR;
         }
+        if (list->linearized && iter != visitedCounter + 1) {
+            logPrint(L_ZERO, 1, "Linearized list [%p] has element #%d in slot %d\n",
+                                list, visitedCounter, iter);
+            return LIST_ORDER_ERROR;
+        }
         visitedCounter++;
     }
     if (visitedCounter > list->reserved) {
@@ -438,26 +1729,32 @@ enum listStatus listVerify(cList_t *list) {
 
     /*checking free*/
     iter = list->free;
-    for (;iter != NULL_LIST_IT && visitedCounter < list->reserved + 5;iter = list->next[iter]) {
-        if (list->next[iter] < 0 || list->next[iter] > list->reserved) {
+    for (;iter != NULL_LIST_IT && visitedCounter < list->reserved + 5;iter = listNextOf(list, iter)) {
+        if (listNextOf(list, iter) < 0 || listNextOf(list, iter) > list->reserved) {
             logPrint(L_ZERO, 1, "Bad iterator in free sequence in list [%p]:\n"
                                 "\tnext[%d] = %d\n"
                                 "\tmaxIter = capacity = %d\n",
-                                list, iter, list->next[iter], list->reserved);
+                                list, iter, listNextOf(list, iter), list->reserved);
             return LIST_NEXT_LINK_ERROR;
         }
 
-        if (list->prev[iter] != INVALID_LIST_IT) {
+        if (listPrevOf(list, iter) != INVALID_LIST_IT) {
             logPrint(L_ZERO, 1, "Found previous element for element from free sequence in list [%p]\n", list);
             return LIST_FREE_LINK_ERROR;
         }
+        if (iter >= list->untouched) {
+            logPrint(L_ZERO, 1, "Free slot %d of list [%p] is in untouched region [%d, %d]\n",
+                                iter, list, list->untouched, list->reserved);
+            return LIST_FREE_LINK_ERROR;
+        }
         visitedCounter++;
     }
 
+    // elements and free sequence together cover everything before untouched region
     if (visitedCounter > list->reserved) {
         logPrint(L_ZERO, 1, "Found loop in list [%p] in free(next) array\n", list);
         return LIST_FREE_LINK_ERROR;
-    } else if (visitedCounter != list->reserved) {
+    } else if (visitedCounter != list->untouched - 1) {
         logPrint(L_ZERO, 1, "Wrong linking in list [%p] in free(next) array\n", list);
         return LIST_FREE_LINK_ERROR;
     }
@@ -465,12 +1762,12 @@ enum listStatus listVerify(cList_t *list) {
     /*checking prev*/
     iter = tale;
     visitedCounter = 0;
-    for (; iter != NULL_LIST_IT && visitedCounter < list->reserved + 5; iter = list->prev[iter]) {
-        if (list->prev[iter] < 0 || list->prev[iter] > list->reserved) {
+    for (; iter != NULL_LIST_IT && visitedCounter < list->reserved + 5; iter = listPrevOf(list, iter)) {
+        if (listPrevOf(list, iter) < 0 || listPrevOf(list, iter) > list->reserved) {
             logPrint(L_ZERO, 1, "Bad iterator in free sequence in list [%p]:\n"
                                 "\tprev[iter] = %d\n"
                                 "\tmaxIter = capacity = %d\n",
-                                list, list->prev[iter], list->reserved);
+                                list, listPrevOf(list, iter), list->reserved);
             return LIST_NEXT_LINK_ERROR;
         }
         visitedCounter++;
@@ -483,6 +1780,9 @@ enum listStatus listVerify(cList_t *list) {
         return LIST_FREE_LINK_ERROR;
     }
 
+    if (list->index)
+        return listIndexVerify(list);
+
     return LIST_SUCCESS;
 }
 
@@ -498,12 +1798,14 @@ enum listStatus listDump(cList_t *list, const char *callMessage) {
     const char *nullElemColor   = "#93AB9D";
     const char *invalidElemColor= "#FD292F";
 
-    static size_t imgNumber = 0;
+    // dumps of different lists may be made from different threads
+    static std::atomic<size_t> dumpCounter(0);
     char buffer[INTERNAL_BUFFER_SIZE] = "";
 
     MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
     if (getLogLevel() < L_DEBUG)
         return LIST_SUCCESS;
+    size_t imgNumber = dumpCounter.fetch_add(1);
 
     logPrintColor(L_ZERO, "#FF0000", "#CCCCCC", "<h2>-------cList_t [%p] dump--------</h2>\n", list);
     logPrint(L_ZERO, 0, "<h2><b>Called with message: %s</b></h2>\n", callMessage);
@@ -517,7 +1819,7 @@ enum listStatus listDump(cList_t *list, const char *callMessage) {
             dotFile);
 
     fprintf(dotFile, "\tnode0 [shape=Mrecord, weight=10, label=\"NULL_ELEMENT | (head) next = %d | (tale) prev = %d\"",
-            list->next[0], list->prev[0]);
+            listNextOf(list, 0), listPrevOf(list, 0));
     fprintf(dotFile, "\tcolor=\"%s\"];\n", nullElemColor);
 
     fprintf(dotFile, "\tsubgraph cluster_Data {\n");
@@ -525,25 +1827,33 @@ enum listStatus listDump(cList_t *list, const char *callMessage) {
     fprintf(dotFile, "\t\tbgcolor=\"#ccfdf9\";\n");
 
     for (int32_t idx = 1; idx <= list->reserved; idx++) {
-        if (memcmp(&LIST_POISON, (char *)list->data + idx * list->elemSize, list->elemSize) == 0)
+        if (idx >= list->untouched) {
+            // links of untouched slots aren't initialized
+            fprintf(dotFile, "\t\tnode%d [shape=Mrecord, style=filled,weight=10, label=\"elem #%d | untouched\","
+                             "fillcolor=\"%s\"];\n", idx, idx, freeColor);
+            continue;
+        }
+
+        if (listIsPoisoned(list, idx))
             sprintf(buffer, "POISON");
         else
-            list->sPrint(buffer, (char *)list->data + idx * list->elemSize);
+            list->sPrint(buffer, listDataOf(list, idx));
 
         fprintf(dotFile, "\t\tnode%d [shape=Mrecord, style=filled,weight=10, label=\"elem #%d | next = %d | prev = %d | val = %s\",",
-                idx, idx, list->next[idx], list->prev[idx], buffer);
+                idx, idx, listNextOf(list, idx), listPrevOf(list, idx), buffer);
 
-        const char *nodeColor = (list->prev[idx] == -1) ? freeColor :
-                                (list->next[0] == idx)  ? headColor :
-                                (list->prev[0] == idx)  ? taleColor :
+        const char *nodeColor = (listPrevOf(list, idx) == -1) ? freeColor :
+                                (listNextOf(list, 0) == idx)  ? headColor :
+                                (listPrevOf(list, 0) == idx)  ? taleColor :
                                 "white";
         fprintf(dotFile, "fillcolor=\"%s\"];\n", nodeColor);
     }
     fprintf(dotFile, "\t}\n");
 
     fprintf(dotFile, "\tnodeHeader [fillcolor = \"%s\", shape=Mrecord, weight=10,"
-                     "label=\"Info | size = %d | capacity = %d\"]\n",
-            headerColor, list->size, list->reserved);
+                     "label=\"Info | size = %d | capacity = %d | untouched from %d | linearized = %d | layout = %s\"]\n",
+            headerColor, list->size, list->reserved, list->untouched, list->linearized,
+            (list->layout == LIST_LAYOUT_AOS) ? "AoS" : "SoA");
 
     fprintf(dotFile,
         "\tlegend [shape=none, weight=10,"
@@ -564,26 +1874,26 @@ enum listStatus listDump(cList_t *list, const char *callMessage) {
         if (idx != list->reserved)
             fprintf(dotFile, "\tnode%d -> node%d [color=\"%s\"];\n", idx, idx+1, invColor);
 
-    for (int32_t idx = 0; idx <= list->reserved; idx++) {
+    for (int32_t idx = 0; idx < list->untouched && idx <= list->reserved; idx++) {
 
-        const char *nextColor = (list->prev[idx] == -1) ? freeColor : goodEdgeColor;
+        const char *nextColor = (listPrevOf(list, idx) == -1) ? freeColor : goodEdgeColor;
         const char *prevColor = NULL;
-        if (list->next[idx] > list->reserved || list->next[idx] < 0) {
+        if (listNextOf(list, idx) > list->reserved || listNextOf(list, idx) < 0) {
             nextColor = nextEdgeColor;
-            fprintf(dotFile, "\tnode%u [color=\"%s\", label=\"Fantom element %d\"];\n", list->next[idx], invalidElemColor, list->next[idx]);
-        } else if (list->prev[idx] != -1 && list->prev[list->next[idx]] != idx)
+            fprintf(dotFile, "\tnode%u [color=\"%s\", label=\"Fantom element %d\"];\n", listNextOf(list, idx), invalidElemColor, listNextOf(list, idx));
+        } else if (listPrevOf(list, idx) != -1 && listPrevOf(list, listNextOf(list, idx)) != idx)
             nextColor = nextEdgeColor;
 
-        if (list->prev[idx] > list->reserved || list->prev[idx] < -1) {
+        if (listPrevOf(list, idx) > list->reserved || listPrevOf(list, idx) < -1) {
             prevColor = nextEdgeColor;
-            fprintf(dotFile, "\tnode%u [color=\"%s\", label=\"Fantom element %d\"];\n", list->prev[idx], invalidElemColor, list->prev[idx]);
-        } else if (list->prev[idx] >= 0 && list->next[list->prev[idx]] != idx)
+            fprintf(dotFile, "\tnode%u [color=\"%s\", label=\"Fantom element %d\"];\n", listPrevOf(list, idx), invalidElemColor, listPrevOf(list, idx));
+        } else if (listPrevOf(list, idx) >= 0 && listNextOf(list, listPrevOf(list, idx)) != idx)
             prevColor = prevEdgeColor;
 
         if (nextColor)
-            fprintf(dotFile, "\tnode%d -> node%u [constraint=false,style=bold,color=\"%s\"];\n", idx, list->next[idx], nextColor);
+            fprintf(dotFile, "\tnode%d -> node%u [constraint=false,style=bold,color=\"%s\"];\n", idx, listNextOf(list, idx), nextColor);
         if (prevColor)
-            fprintf(dotFile, "\tnode%d -> node%u [constraint=false,style=bold,color=\"%s\"];\n", idx, list->prev[idx], prevColor);
+            fprintf(dotFile, "\tnode%d -> node%u [constraint=false,style=bold,color=\"%s\"];\n", idx, listPrevOf(list, idx), prevColor);
 
     }
 
@@ -600,6 +1910,5 @@ enum listStatus listDump(cList_t *list, const char *callMessage) {
     logPrint(L_ZERO, 0, "\n<hr>\n");
     logFlush();
 
-    imgNumber++;
     return LIST_SUCCESS;
 }
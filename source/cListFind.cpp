@@ -0,0 +1,265 @@
+/// @file
+/// @brief Order independent search over physical storage of cList_t
+/// Payloads of SoA list lie in one contiguous array, so they are compared by
+/// SIMD blocks of LIST_SCAN_BLOCK slots, free slots are filtered out by prev
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#if defined(__SSE2__)
+# include <immintrin.h>
+#endif
+
+#include "error_debug.h"
+#include "logger.h"
+#include "cList.h"
+#include "cListIndex.h"
+
+/// Slots compared by one call of block matcher, bit i of result is set if slot i matches
+const int32_t LIST_SCAN_BLOCK = 32;
+
+/// @brief Compares LIST_SCAN_BLOCK consecutive payloads with key
+typedef uint32_t (*listBlockMatcher_t)(const char *block, const char *key);
+
+/*------------------SCALAR MATCHERS-------------------------------------------*/
+#if !defined(__SSE2__)
+
+static uint32_t matchScalar4(const char *block, const char *key) {
+    uint32_t keyVal = 0, mask = 0;
+    memcpy(&keyVal, key, sizeof(keyVal));
+    for (int32_t idx = 0; idx < LIST_SCAN_BLOCK; idx++) {
+        uint32_t val = 0;
+        memcpy(&val, block + idx * 4, sizeof(val));
+        mask |= (uint32_t) (val == keyVal) << idx;
+    }
+    return mask;
+}
+
+static uint32_t matchScalar8(const char *block, const char *key) {
+    uint64_t keyVal = 0;
+    uint32_t mask = 0;
+    memcpy(&keyVal, key, sizeof(keyVal));
+    for (int32_t idx = 0; idx < LIST_SCAN_BLOCK; idx++) {
+        uint64_t val = 0;
+        memcpy(&val, block + idx * 8, sizeof(val));
+        mask |= (uint32_t) (val == keyVal) << idx;
+    }
+    return mask;
+}
+
+static uint32_t matchScalar16(const char *block, const char *key) {
+    uint64_t keyLo = 0, keyHi = 0;
+    uint32_t mask = 0;
+    memcpy(&keyLo, key, sizeof(keyLo));
+    memcpy(&keyHi, key + 8, sizeof(keyHi));
+    for (int32_t idx = 0; idx < LIST_SCAN_BLOCK; idx++) {
+        uint64_t lo = 0, hi = 0;
+        memcpy(&lo, block + idx * 16, sizeof(lo));
+        memcpy(&hi, block + idx * 16 + 8, sizeof(hi));
+        mask |= (uint32_t) (lo == keyLo && hi == keyHi) << idx;
+    }
+    return mask;
+}
+
+#endif
+
+/*------------------SSE2 MATCHERS---------------------------------------------*/
+#if defined(__SSE2__)
+
+static uint32_t matchSse4(const char *block, const char *key) {
+    int32_t keyVal = 0;
+    memcpy(&keyVal, key, sizeof(keyVal));
+    __m128i keyVec = _mm_set1_epi32(keyVal);
+    uint32_t mask = 0;
+    for (int32_t idx = 0; idx < LIST_SCAN_BLOCK; idx += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (block + idx * 4)), keyVec);
+        mask |= (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(eq)) << idx;
+    }
+    return mask;
+}
+
+static uint32_t matchSse8(const char *block, const char *key) {
+    int64_t keyVal = 0;
+    memcpy(&keyVal, key, sizeof(keyVal));
+    __m128i keyVec = _mm_set1_epi64x(keyVal);
+    uint32_t mask = 0;
+    for (int32_t idx = 0; idx < LIST_SCAN_BLOCK; idx += 2) {
+        // SSE2 has no 64-bit compare, element matches if both of its halves do
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (block + idx * 8)), keyVec);
+        uint32_t halves = (uint32_t) _mm_movemask_ps(_mm_castsi128_ps(eq));
+        mask |= (uint32_t) (((halves & 0x3) == 0x3) | (((halves & 0xC) == 0xC) << 1)) << idx;
+    }
+    return mask;
+}
+
+static uint32_t matchSse16(const char *block, const char *key) {
+    __m128i keyVec = _mm_loadu_si128((const __m128i *) key);
+    uint32_t mask = 0;
+    for (int32_t idx = 0; idx < LIST_SCAN_BLOCK; idx++) {
+        __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (block + idx * 16)), keyVec);
+        mask |= (uint32_t) (_mm_movemask_epi8(eq) == 0xFFFF) << idx;
+    }
+    return mask;
+}
+
+#endif
+
+/*------------------AVX2 MATCHERS---------------------------------------------*/
+// compiled with target attribute and chosen at runtime, so build flags stay generic
+#if defined(__SSE2__) && defined(__x86_64__) && defined(__GNUC__)
+# define LIST_SCAN_AVX2 1
+
+__attribute__((target("avx2")))
+static uint32_t matchAvx4(const char *block, const char *key) {
+    int32_t keyVal = 0;
+    memcpy(&keyVal, key, sizeof(keyVal));
+    __m256i keyVec = _mm256_set1_epi32(keyVal);
+    uint32_t mask = 0;
+    for (int32_t idx = 0; idx < LIST_SCAN_BLOCK; idx += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) (block + idx * 4)), keyVec);
+        mask |= (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(eq)) << idx;
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+static uint32_t matchAvx8(const char *block, const char *key) {
+    int64_t keyVal = 0;
+    memcpy(&keyVal, key, sizeof(keyVal));
+    __m256i keyVec = _mm256_set1_epi64x(keyVal);
+    uint32_t mask = 0;
+    for (int32_t idx = 0; idx < LIST_SCAN_BLOCK; idx += 4) {
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *) (block + idx * 8)), keyVec);
+        mask |= (uint32_t) _mm256_movemask_pd(_mm256_castsi256_pd(eq)) << idx;
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+static uint32_t matchAvx16(const char *block, const char *key) {
+    __m256i keyVec = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) key));
+    uint32_t mask = 0;
+    for (int32_t idx = 0; idx < LIST_SCAN_BLOCK; idx += 2) {
+        // element matches if both of its 64-bit halves do
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *) (block + idx * 16)), keyVec);
+        uint32_t halves = (uint32_t) _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+        mask |= (uint32_t) (((halves & 0x3) == 0x3) | (((halves & 0xC) == 0xC) << 1)) << idx;
+    }
+    return mask;
+}
+
+#endif
+
+/// @brief Best matcher for element size on this CPU, NULL if size isn't supported
+static listBlockMatcher_t listChooseMatcher(size_t elemSize) {
+#ifdef LIST_SCAN_AVX2
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if (hasAvx2) {
+        switch (elemSize) {
+            case 4:  return matchAvx4;
+            case 8:  return matchAvx8;
+            case 16: return matchAvx16;
+            default: return NULL;
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    switch (elemSize) {
+        case 4:  return matchSse4;
+        case 8:  return matchSse8;
+        case 16: return matchSse16;
+        default: return NULL;
+    }
+#else
+    switch (elemSize) {
+        case 4:  return matchScalar4;
+        case 8:  return matchScalar8;
+        case 16: return matchScalar16;
+        default: return NULL;
+    }
+#endif
+}
+
+/// @brief Add matching slot to results, return true if scan should stop
+static inline bool listScanReport(listIterator_t slot, listIterator_t *found, size_t maxFound,
+                                  int32_t *count, bool stopOnFirst) {
+    if (found && (size_t) *count < maxFound)
+        found[*count] = slot;
+    (*count)++;
+    return stopOnFirst;
+}
+
+/*! @brief Slot by slot scan of [slot, untouched), used for AoS lists and tails of SoA scan
+    elemSize = 0 means runtime element size, otherwise memcmp is inlined as plain loads
+!*/
+template <size_t elemSize>
+static int32_t listScanSlots(cList_t *list, const char *key, int32_t slot, listIterator_t *found,
+                             size_t maxFound, int32_t count, bool stopOnFirst) {
+    const size_t size = elemSize ? elemSize : list->elemSize;
+    for (; slot < list->untouched; slot++) {
+        if (listPrevOf(list, slot) != INVALID_LIST_IT &&
+            memcmp(listDataOf(list, slot), key, size) == 0 &&
+            listScanReport(slot, found, maxFound, &count, stopOnFirst))
+            return count;
+    }
+    return count;
+}
+
+/*! @brief Scan slots [1, untouched) in physical order
+    @return Number of live elements equal to elem, at most 1 if stopOnFirst
+!*/
+static int32_t listScan(cList_t *list, const void *elem, listIterator_t *found, size_t maxFound, bool stopOnFirst) {
+    const char *key = (const char *) elem;
+    int32_t count = 0;
+    int32_t slot  = 1;
+
+    // AoS payloads aren't contiguous, so only SoA storage is scanned by blocks
+    listBlockMatcher_t matcher = (list->layout == LIST_LAYOUT_SOA) ? listChooseMatcher(list->elemSize) : NULL;
+    if (matcher) {
+        const char *data = (const char *) list->data;
+        for (; slot + LIST_SCAN_BLOCK <= list->untouched; slot += LIST_SCAN_BLOCK) {
+            uint32_t mask = matcher(data + (size_t) slot * list->elemSize, key);
+            // matches are rare, so free slots are filtered only among them
+            for (; mask; mask &= mask - 1) {
+                listIterator_t match = slot + __builtin_ctz(mask);
+                if (listPrevOf(list, match) != INVALID_LIST_IT &&
+                    listScanReport(match, found, maxFound, &count, stopOnFirst))
+                    return count;
+            }
+        }
+    }
+
+    switch (list->elemSize) {
+        case 4:  return listScanSlots<4> (list, key, slot, found, maxFound, count, stopOnFirst);
+        case 8:  return listScanSlots<8> (list, key, slot, found, maxFound, count, stopOnFirst);
+        case 16: return listScanSlots<16>(list, key, slot, found, maxFound, count, stopOnFirst);
+        default: return listScanSlots<0> (list, key, slot, found, maxFound, count, stopOnFirst);
+    }
+}
+
+listIterator_t listFindAny(cList_t *list, const void *elem) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(elem, exit(LIST_NULL_PTR_ERROR));
+    LIST_CUSTOM_ASSERT(list, INVALID_LIST_IT);
+
+    bool duplicates = false;
+    if (list->index)
+        return listIndexLookup(list, elem, &duplicates);
+
+    listIterator_t found = INVALID_LIST_IT;
+    listScan(list, elem, &found, 1, true);
+    return found;
+}
+
+int32_t listFindAll(cList_t *list, const void *elem, listIterator_t *found, size_t maxFound) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(elem, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(found || maxFound == 0, exit(LIST_NULL_PTR_ERROR));
+    LIST_CUSTOM_ASSERT(list, -1);
+
+    return listScan(list, elem, found, maxFound, false);
+}
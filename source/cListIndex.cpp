@@ -0,0 +1,203 @@
+/// @file
+/// @brief Optional hash index of cList_t, makes listFind expected O(1)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "error_debug.h"
+#include "logger.h"
+#include "cList.h"
+#include "cListIndex.h"
+
+/// @brief Hash of payload, processes 8 bytes per step unlike byte-wise memHash
+static uint64_t listHashPayload(const void *elem, size_t size) {
+    const uint64_t mul = 0x9E3779B97F4A7C15ULL;
+    const char *bytes = (const char *) elem;
+    uint64_t hash = size * mul;
+
+    for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        memcpy(&word, bytes, sizeof(word));
+        hash = (hash ^ word) * mul;
+        hash ^= hash >> 29;
+    }
+    if (size > 0) {
+        uint64_t word = 0;
+        memcpy(&word, bytes, size);
+        hash = (hash ^ word) * mul;
+    }
+
+    // murmur3 finalizer, low bits select bucket, so they must depend on all input bits
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static int32_t *listIndexBucketOf(cList_t *list, const void *elem) {
+    listHashIndex_t *index = list->index;
+    return &index->buckets[listHashPayload(elem, list->elemSize) & index->bucketMask];
+}
+
+/// @brief Smallest power of two that is not less than capacity
+static size_t listIndexBucketCount(size_t capacity) {
+    size_t count = 1;
+    while (count < capacity)
+        count *= 2;
+    return count;
+}
+
+void listIndexInsert(cList_t *list, listIterator_t slot) {
+    int32_t *bucket = listIndexBucketOf(list, listDataOf(list, slot));
+    list->index->chain[slot] = *bucket;
+    *bucket = slot;
+}
+
+void listIndexRemove(cList_t *list, listIterator_t slot) {
+    int32_t *link = listIndexBucketOf(list, listDataOf(list, slot));
+    while (*link != NULL_LIST_IT && *link != slot)
+        link = &list->index->chain[*link];
+
+    if (*link == slot)
+        *link = list->index->chain[slot];
+}
+
+void listIndexClear(cList_t *list) {
+    listHashIndex_t *index = list->index;
+    memset(index->buckets, 0, (index->bucketMask + 1) * sizeof(int32_t));
+}
+
+void listIndexRebuild(cList_t *list) {
+    listIndexClear(list);
+    for (listIterator_t iter = listNextOf(list, 0); iter != NULL_LIST_IT; iter = listNextOf(list, iter))
+        listIndexInsert(list, iter);
+}
+
+enum listStatus listIndexReserve(cList_t *list, size_t capacity) {
+    listHashIndex_t *index = list->index;
+
+    if (capacity > index->chainSize) {
+        int32_t *chain = (int32_t *) realloc(index->chain, capacity * sizeof(int32_t));
+        if (!chain) {
+            logPrint(L_ZERO, 1, "Reallocation of index chain of list [%p] failed\n", list);
+            return LIST_MEMORY_ERROR;
+        }
+        index->chain     = chain;
+        index->chainSize = capacity;
+    }
+
+    // load factor is kept under 1, chains are rehashed into new buckets
+    size_t bucketCount = listIndexBucketCount(capacity);
+    if (bucketCount <= index->bucketMask + 1)
+        return LIST_SUCCESS;
+
+    int32_t *buckets = (int32_t *) calloc(bucketCount, sizeof(int32_t));
+    if (!buckets) {
+        logPrint(L_ZERO, 1, "Allocation of index buckets of list [%p] failed\n", list);
+        return LIST_MEMORY_ERROR;
+    }
+    free(index->buckets);
+    index->buckets    = buckets;
+    index->bucketMask = bucketCount - 1;
+
+    listIndexRebuild(list);
+    return LIST_SUCCESS;
+}
+
+listIterator_t listIndexLookup(cList_t *list, const void *elem, bool *duplicates) {
+    listIterator_t found = INVALID_LIST_IT;
+    *duplicates = false;
+
+    for (listIterator_t slot = *listIndexBucketOf(list, elem); slot != NULL_LIST_IT; slot = list->index->chain[slot]) {
+        if (memcmp(listDataOf(list, slot), elem, list->elemSize) != 0)
+            continue;
+        if (found != INVALID_LIST_IT) {
+            *duplicates = true;
+            break;
+        }
+        found = slot;
+    }
+    return found;
+}
+
+enum listStatus listIndexVerify(cList_t *list) {
+    listHashIndex_t *index = list->index;
+    if (!index->buckets || !index->chain || index->chainSize < (size_t) list->reserved + 1) {
+        logPrint(L_ZERO, 1, "Index of list [%p] isn't allocated for %d slots\n", list, list->reserved);
+        return LIST_MEMORY_ERROR;
+    }
+
+    int32_t indexed = 0;
+    for (size_t bucket = 0; bucket <= index->bucketMask; bucket++) {
+        for (listIterator_t slot = index->buckets[bucket]; slot != NULL_LIST_IT; slot = index->chain[slot]) {
+            if (slot < 0 || slot > list->reserved || listSlotIsFree(list, slot) || indexed >= list->size) {
+                logPrint(L_ZERO, 1, "Index of list [%p] has bad slot %d in bucket %zu\n", list, slot, bucket);
+                return LIST_ERROR;
+            }
+            if (listIndexBucketOf(list, listDataOf(list, slot)) != &index->buckets[bucket]) {
+                logPrint(L_ZERO, 1, "Element %d of list [%p] is in wrong index bucket %zu, "
+                                    "was payload modified in place?\n", slot, list, bucket);
+                return LIST_ERROR;
+            }
+            indexed++;
+        }
+    }
+    if (indexed != list->size) {
+        logPrint(L_ZERO, 1, "Index of list [%p] has %d elements, list has %d\n", list, indexed, list->size);
+        return LIST_ERROR;
+    }
+    return LIST_SUCCESS;
+}
+
+enum listStatus listEnableIndex(cList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+
+    if (list->index)
+        return LIST_SUCCESS;
+
+    logPrint(L_DEBUG, 0, "Building hash index of list [%p]\n", list);
+    list->index = (listHashIndex_t *) calloc(1, sizeof(listHashIndex_t));
+    if (!list->index) {
+        logPrint(L_ZERO, 1, "Allocation of index of list [%p] failed\n", list);
+        return LIST_MEMORY_ERROR;
+    }
+
+    // empty index with one bucket, reserve grows it and inserts all elements
+    list->index->buckets = (int32_t *) calloc(1, sizeof(int32_t));
+    if (!list->index->buckets || listIndexReserve(list, (size_t) list->reserved + 1) != LIST_SUCCESS) {
+        listDisableIndex(list);
+        return LIST_MEMORY_ERROR;
+    }
+
+    LIST_ASSERT(list);
+    return LIST_SUCCESS;
+}
+
+enum listStatus listDisableIndex(cList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    if (!list->index)
+        return LIST_SUCCESS;
+
+    free(list->index->buckets);
+    free(list->index->chain);
+    free(list->index);
+    list->index = NULL;
+    return LIST_SUCCESS;
+}
+
+size_t listIndexMemory(const cList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    if (!list->index)
+        return 0;
+    return sizeof(listHashIndex_t) + (list->index->bucketMask + 1) * sizeof(int32_t)
+                                   + list->index->chainSize * sizeof(int32_t);
+}
@@ -0,0 +1,387 @@
+/// @file
+/// @brief Append-only journal of cList_t modifications and its replay over snapshot
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "error_debug.h"
+#include "logger.h"
+#include "cList.h"
+#include "cListJournal.h"
+
+/// Identifies journal file
+const char     LIST_JOURNAL_MAGIC[8] = {'c', 'L', 'i', 's', 't', 'J', 'r', 'n'};
+/// Changes whenever header or record layout changes
+const uint32_t LIST_JOURNAL_VERSION  = 2;
+
+/// @brief First bytes of journal, describe list state journal starts from
+typedef struct listJournalHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t layout;
+    uint64_t elemSize;
+    int32_t  size;
+    int32_t  free;
+    int32_t  untouched;
+    int32_t  reserved;
+    uint64_t generation;    ///< Checkpoint generation of snapshot journal starts from
+} listJournalHeader_t;
+
+/// @brief Write whole buffer to fd, retrying short writes
+static bool listJournalWriteAll(int fd, const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+        data += written;
+        size -= (size_t) written;
+    }
+    return true;
+}
+
+static void listJournalFail(cList_t *list) {
+    if (!list->journal->failed)
+        logPrint(L_ZERO, 1, "Writing journal %s of list [%p] failed, journal is stopped\n", list->journal->path, list);
+    list->journal->failed = true;
+}
+
+/// @brief Write buffered records to file
+static void listJournalFlush(cList_t *list) {
+    listJournal_t *journal = list->journal;
+    if (journal->failed || journal->buffered == 0)
+        return;
+
+    if (!listJournalWriteAll(journal->fd, journal->buffer, journal->buffered))
+        listJournalFail(list);
+    journal->buffered = 0;
+}
+
+static void listJournalAppend(cList_t *list, const void *data, size_t size) {
+    listJournal_t *journal = list->journal;
+    if (journal->failed)
+        return;
+
+    if (journal->buffered + size > journal->policy.bufferSize)
+        listJournalFlush(list);
+    // data larger than buffer goes to file directly
+    if (size > journal->policy.bufferSize) {
+        if (!listJournalWriteAll(journal->fd, (const char *) data, size))
+            listJournalFail(list);
+        return;
+    }
+    memcpy(journal->buffer + journal->buffered, data, size);
+    journal->buffered += size;
+}
+
+/// @brief Count finished record and sync journal if policy asks for it
+static void listJournalCommit(cList_t *list) {
+    listJournal_t *journal = list->journal;
+    journal->unsynced++;
+    if (journal->policy.recordsPerSync != 0 && journal->unsynced >= journal->policy.recordsPerSync)
+        listJournalSync(list);
+}
+
+void listJournalInsert(cList_t *list, listIterator_t iter, listIterator_t first, int32_t count) {
+    listJournalRecord_t record = {LIST_JOURNAL_INSERT, iter, first, NULL_LIST_IT, count};
+    listJournalAppend(list, &record, sizeof(record));
+
+    // payloads are written in list order, replay inserts them as one range
+    listIterator_t elem = first;
+    for (int32_t idx = 0; idx < count; idx++, elem = listNextOf(list, elem))
+        listJournalAppend(list, listDataOf(list, elem), list->elemSize);
+    listJournalCommit(list);
+}
+
+void listJournalRemove(cList_t *list, listIterator_t first, listIterator_t last) {
+    listJournalOperation(list, LIST_JOURNAL_REMOVE, NULL_LIST_IT, first, last);
+}
+
+void listJournalOperation(cList_t *list, enum listJournalOp op, listIterator_t iter,
+                          listIterator_t first, listIterator_t last) {
+    listJournalRecord_t record = {(uint32_t) op, iter, first, last, 0};
+    listJournalAppend(list, &record, sizeof(record));
+    listJournalCommit(list);
+}
+
+void listJournalOrder(cList_t *list, enum listJournalOp op) {
+    listJournalRecord_t record = {(uint32_t) op, NULL_LIST_IT, NULL_LIST_IT, NULL_LIST_IT, list->size};
+    listJournalAppend(list, &record, sizeof(record));
+
+    for (listIterator_t iter = listNextOf(list, 0); iter != NULL_LIST_IT; iter = listNextOf(list, iter))
+        listJournalAppend(list, &iter, sizeof(iter));
+    listJournalCommit(list);
+}
+
+enum listStatus listJournalAttach(cList_t *list, const char *path, listJournalPolicy_t policy) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(path, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+
+    if (list->journal) {
+        logPrint(L_ZERO, 1, "List [%p] already has journal %s\n", list, list->journal->path);
+        return LIST_ERROR;
+    }
+    if (policy.bufferSize < sizeof(listJournalRecord_t)) {
+        logPrint(L_ZERO, 1, "Journal buffer of %zu bytes can't hold one record\n", policy.bufferSize);
+        return LIST_SIZE_ERROR;
+    }
+    logPrint(L_DEBUG, 0, "Starting journal %s of list [%p]\n", path, list);
+
+    listJournal_t *journal = (listJournal_t *) calloc(1, sizeof(listJournal_t));
+    if (!journal)
+        return LIST_MEMORY_ERROR;
+    journal->fd     = -1;
+    journal->policy = policy;
+    journal->path   = (char *) calloc(strlen(path) + 1, 1);
+    journal->buffer = (char *) malloc(policy.bufferSize);
+    if (!journal->path || !journal->buffer) {
+        free(journal->path);
+        free(journal->buffer);
+        free(journal);
+        return LIST_MEMORY_ERROR;
+    }
+    strcpy(journal->path, path);
+    list->journal = journal;
+
+    listJournalHeader_t header = {};
+    memcpy(header.magic, LIST_JOURNAL_MAGIC, sizeof(header.magic));
+    header.version   = LIST_JOURNAL_VERSION;
+    header.layout    = (uint32_t) list->layout;
+    header.elemSize  = list->elemSize;
+    header.size      = list->size;
+    header.free      = list->free;
+    header.untouched = list->untouched;
+    header.reserved  = list->reserved;
+    header.generation = list->generation;
+
+    // header is synced at once, so existing journal always belongs to some snapshot
+    journal->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (journal->fd < 0 || !listJournalWriteAll(journal->fd, (const char *) &header, sizeof(header)) ||
+        fdatasync(journal->fd) != 0) {
+        logPrint(L_ZERO, 1, "Can't start journal %s of list [%p]\n", path, list);
+        listJournalDetach(list);
+        return LIST_FILE_ERROR;
+    }
+    return LIST_SUCCESS;
+}
+
+enum listStatus listJournalSync(cList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    listJournal_t *journal = list->journal;
+    if (!journal)
+        return LIST_ERROR;
+
+    listJournalFlush(list);
+    if (!journal->failed && fdatasync(journal->fd) != 0)
+        listJournalFail(list);
+    journal->unsynced = 0;
+    return journal->failed ? LIST_FILE_ERROR : LIST_SUCCESS;
+}
+
+enum listStatus listJournalCheckpoint(cList_t *list, const char *snapshotPath) {
+    MY_ASSERT(list,         exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(snapshotPath, exit(LIST_NULL_PTR_ERROR));
+
+    if (!list->journal)
+        return LIST_ERROR;
+
+    // snapshot of new generation is durable before journal restarts, crash in between
+    // leaves journal of older generation, which replay skips
+    list->generation++;
+    enum listStatus status = listSaveToFile(list, snapshotPath);
+    if (status != LIST_SUCCESS) {
+        list->generation--;
+        return status;
+    }
+
+    listJournalPolicy_t policy = list->journal->policy;
+    char *path = list->journal->path;
+    list->journal->path = NULL;
+
+    // records already in snapshot don't need to be written
+    list->journal->buffered = 0;
+    listJournalDetach(list);
+    status = listJournalAttach(list, path, policy);
+    free(path);
+    return status;
+}
+
+enum listStatus listJournalDetach(cList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    listJournal_t *journal = list->journal;
+    if (!journal)
+        return LIST_SUCCESS;
+
+    enum listStatus status = LIST_SUCCESS;
+    if (journal->fd >= 0) {
+        status = listJournalSync(list);
+        if (close(journal->fd) != 0)
+            status = LIST_FILE_ERROR;
+    }
+
+    free(journal->path);
+    free(journal->buffer);
+    free(journal);
+    list->journal = NULL;
+    return status;
+}
+
+/// @brief Read exactly size bytes, false on end of file
+static bool listJournalRead(FILE *file, void *data, size_t size) {
+    return size == 0 || fread(data, size, 1, file) == 1;
+}
+
+/*! @brief Apply one record to list, its payloads or slots are read from file
+    @param torn [out] Set to true if file ended in the middle of record
+!*/
+static enum listStatus listJournalApply(cList_t *list, FILE *file, const listJournalRecord_t *record,
+                                        char **scratch, size_t *scratchSize, bool *torn) {
+    size_t itemSize = 0;
+    if (record->op == LIST_JOURNAL_INSERT)
+        itemSize = list->elemSize;
+    else if (record->op == LIST_JOURNAL_SORT || record->op == LIST_JOURNAL_SORT_LINEARIZE)
+        itemSize = sizeof(int32_t);
+
+    if (record->count < 0 || (itemSize == 0 && record->count != 0))
+        return LIST_FILE_ERROR;
+
+    size_t dataSize = itemSize * (size_t) record->count;
+    if (dataSize > *scratchSize) {
+        char *newScratch = (char *) realloc(*scratch, dataSize);
+        if (!newScratch)
+            return LIST_MEMORY_ERROR;
+        *scratch     = newScratch;
+        *scratchSize = dataSize;
+    }
+    if (!listJournalRead(file, *scratch, dataSize)) {
+        *torn = true;
+        return LIST_SUCCESS;
+    }
+
+    switch ((enum listJournalOp) record->op) {
+        case LIST_JOURNAL_INSERT:
+            // the same slots must be taken, otherwise journal doesn't belong to snapshot
+            if (listInsertRangeAfter(list, record->iter, *scratch, (size_t) record->count) != record->first)
+                return LIST_FILE_ERROR;
+            return LIST_SUCCESS;
+        case LIST_JOURNAL_REMOVE:
+            if (record->first == record->last)
+                return (listRemove(list, record->first) == LIST_SUCCESS) ? LIST_SUCCESS : LIST_FILE_ERROR;
+            return (listRemoveRange(list, record->first, record->last) == LIST_SUCCESS) ? LIST_SUCCESS : LIST_FILE_ERROR;
+        case LIST_JOURNAL_CLEAR:
+            return listClear(list);
+        case LIST_JOURNAL_MOVE:
+            if (listSplice(list, record->iter, list, record->first, record->last) != record->first)
+                return LIST_FILE_ERROR;
+            return LIST_SUCCESS;
+        case LIST_JOURNAL_LINEARIZE:
+            return listLinearize(list);
+        case LIST_JOURNAL_SHRINK:
+            return listShrinkToFit(list, NULL);
+        case LIST_JOURNAL_SORT:
+        case LIST_JOURNAL_SORT_LINEARIZE:
+            if (listApplyOrder(list, (const int32_t *) (void *) *scratch, record->count,
+                               record->op == LIST_JOURNAL_SORT_LINEARIZE) != LIST_SUCCESS)
+                return LIST_FILE_ERROR;
+            return LIST_SUCCESS;
+        case LIST_JOURNAL_END:
+        case LIST_JOURNAL_OP_COUNT:
+        default:
+            return LIST_FILE_ERROR;
+    }
+}
+
+/// @brief Check that header is journal header of this version
+static bool listJournalHeaderIsValid(const listJournalHeader_t *header) {
+    return memcmp(header->magic, LIST_JOURNAL_MAGIC, sizeof(header->magic)) == 0 &&
+           header->version == LIST_JOURNAL_VERSION;
+}
+
+/// @brief Check that journal starts from state of list loaded from snapshot
+static bool listJournalHeaderMatches(const listJournalHeader_t *header, const cList_t *list) {
+    return listJournalHeaderIsValid(header) && header->generation == list->generation &&
+           header->layout == (uint32_t) list->layout &&
+           header->elemSize == list->elemSize && header->size == list->size && header->free == list->free &&
+           header->untouched == list->untouched && header->reserved == list->reserved;
+}
+
+enum listStatus listJournalReplay(cList_t *list, const char *snapshotPath, const char *journalPath,
+                                  listPrintFunction_t sPrint) {
+    MY_ASSERT(list,         exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(snapshotPath, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(journalPath,  exit(LIST_NULL_PTR_ERROR));
+
+    FILE *file = fopen(journalPath, "rb");
+    if (!file) {
+        logPrint(L_ZERO, 1, "Can't open journal %s\n", journalPath);
+        return LIST_FILE_ERROR;
+    }
+
+    enum listStatus status = listMapFile(list, snapshotPath, sPrint);
+    if (status != LIST_SUCCESS) {
+        fclose(file);
+        return status;
+    }
+    logPrint(L_DEBUG, 0, "Replaying journal %s over snapshot %s in list [%p]\n", journalPath, snapshotPath, list);
+
+    // journal without complete header or of older generation was being restarted
+    // by checkpoint when process crashed, its snapshot is already durable
+    listJournalHeader_t header = {};
+    bool current = !listJournalRead(file, &header, sizeof(header)) ||
+                   (listJournalHeaderIsValid(&header) && header.generation < list->generation);
+    if (current) {
+        logPrint(L_ZERO, 0, "Journal %s is older than snapshot %s, snapshot is current\n", journalPath, snapshotPath);
+        fclose(file);
+        return LIST_SUCCESS;
+    }
+    if (!listJournalHeaderMatches(&header, list)) {
+        logPrint(L_ZERO, 1, "Journal %s doesn't start from snapshot %s\n", journalPath, snapshotPath);
+        status = LIST_FILE_ERROR;
+    }
+
+    char  *scratch     = NULL;
+    size_t scratchSize = 0,
+           records     = 0;
+    bool   torn        = false;
+    while (status == LIST_SUCCESS) {
+        listJournalRecord_t record = {};
+        size_t got = fread(&record, 1, sizeof(record), file);
+        if (got == 0 || record.op == LIST_JOURNAL_END) {
+            torn = torn || got != 0;
+            break;
+        }
+        if (got < sizeof(record)) {
+            torn = true;
+            break;
+        }
+
+        status = listJournalApply(list, file, &record, &scratch, &scratchSize, &torn);
+        if (torn)
+            break;
+        if (status != LIST_SUCCESS)
+            logPrint(L_ZERO, 1, "Record %zu (operation %u) of journal %s can't be applied\n",
+                                records, record.op, journalPath);
+        records++;
+    }
+    if (torn)
+        logPrint(L_ZERO, 0, "Journal %s ends with incomplete record after %zu records\n", journalPath, records);
+
+    free(scratch);
+    fclose(file);
+    if (status != LIST_SUCCESS) {
+        listDtor(list);
+        return status;
+    }
+    return LIST_SUCCESS;
+}
@@ -0,0 +1,152 @@
+/// @file
+/// @brief Parallel for-each and reduce over elements of cList_t
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "error_debug.h"
+#include "logger.h"
+#include "cList.h"
+#include "cListParallel.h"
+
+/// Partial results of threads are kept on different cache lines
+const size_t LIST_PARALLEL_CACHE_LINE = 64;
+
+/// @brief Number of chunks: requested threads, but no chunk smaller than LIST_PARALLEL_MIN_CHUNK
+static unsigned listParallelChunks(const cList_t *list, unsigned threads) {
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+
+    unsigned maxChunks = (unsigned) (list->size / LIST_PARALLEL_MIN_CHUNK);
+    if (threads > maxChunks)
+        threads = maxChunks;
+    return (threads > 0) ? threads : 1;
+}
+
+/*! @brief Split list into chunks and call body(chunk, iter) for every element of every chunk
+    Chunks except first are processed by new threads, chunk is processed by calling
+    thread if its thread can't be created
+!*/
+template <typename Body>
+static enum listStatus listRunChunks(cList_t *list, enum listParallelOrder order, unsigned chunks, Body body) {
+    // first element of every chunk in logical order, found before threads start
+    std::vector<listIterator_t> chunkFirst;
+    if (order == LIST_PARALLEL_IN_ORDER) {
+        try {
+            chunkFirst.resize(chunks);
+        } catch (const std::bad_alloc &) {
+            return LIST_MEMORY_ERROR;
+        }
+
+        listIterator_t iter = listNextOf(list, 0);
+        int32_t position = 0;
+        for (unsigned chunk = 0; chunk < chunks; chunk++) {
+            int32_t chunkStart = (int32_t) ((int64_t) list->size * chunk / chunks);
+            if (list->linearized) {
+                chunkFirst[chunk] = chunkStart + 1;
+                continue;
+            }
+            for (; position < chunkStart; position++)
+                iter = listNextOf(list, iter);
+            chunkFirst[chunk] = iter;
+        }
+    }
+
+    auto runChunk = [list, order, chunks, &chunkFirst, &body](unsigned chunk) {
+        if (order == LIST_PARALLEL_ANY_ORDER) {
+            // slots [1, untouched) are sliced evenly, free ones are skipped
+            int64_t slots = list->untouched - 1;
+            int32_t begin = 1 + (int32_t) (slots * chunk / chunks),
+                    end   = 1 + (int32_t) (slots * (chunk + 1) / chunks);
+            for (int32_t slot = begin; slot < end; slot++)
+                if (listPrevOf(list, slot) != INVALID_LIST_IT)
+                    body(chunk, slot);
+        } else {
+            int32_t count = (int32_t) ((int64_t) list->size * (chunk + 1) / chunks -
+                                       (int64_t) list->size * chunk / chunks);
+            listIterator_t iter = chunkFirst[chunk];
+            for (int32_t idx = 0; idx < count; idx++, iter = listNextOf(list, iter))
+                body(chunk, iter);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned chunk = 1; chunk < chunks; chunk++) {
+        try {
+            workers.emplace_back(runChunk, chunk);
+        } catch (const std::exception &) {
+            logPrint(L_DEBUG, 0, "Can't start thread for chunk %u of list [%p], processing it in place\n", chunk, list);
+            runChunk(chunk);
+        }
+    }
+    runChunk(0);
+
+    for (std::thread &worker : workers)
+        worker.join();
+    return LIST_SUCCESS;
+}
+
+enum listStatus listParallelForEach(cList_t *list, listElemVisitor_t visitor, void *ctx,
+                                    enum listParallelOrder order, unsigned threads) {
+    MY_ASSERT(list,    exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(visitor, exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+
+    // visitor may change payloads, snapshots of list must not see that
+    enum listStatus status = listMakeWritable(list);
+    if (status != LIST_SUCCESS)
+        return status;
+
+    unsigned chunks = listParallelChunks(list, threads);
+    logPrint(L_DEBUG, 0, "Parallel for-each over list [%p] in %u chunks\n", list, chunks);
+
+    return listRunChunks(list, order, chunks, [list, visitor, ctx](unsigned, listIterator_t iter) {
+        visitor(listDataOf(list, iter), iter, ctx);
+    });
+}
+
+enum listStatus listParallelReduce(cList_t *list, void *result, size_t resultSize, const void *identity,
+                                   listReduceStep_t step, listReduceCombine_t combine, void *ctx,
+                                   enum listParallelOrder order, unsigned threads) {
+    MY_ASSERT(list,     exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(result,   exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(identity, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(step,     exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(combine,  exit(LIST_NULL_PTR_ERROR));
+    LIST_ASSERT(list);
+
+    unsigned chunks = listParallelChunks(list, threads);
+    logPrint(L_DEBUG, 0, "Parallel reduce over list [%p] in %u chunks\n", list, chunks);
+
+    size_t stride = (resultSize + LIST_PARALLEL_CACHE_LINE - 1) / LIST_PARALLEL_CACHE_LINE * LIST_PARALLEL_CACHE_LINE;
+    char *partials = (char *) calloc(chunks, stride);
+    if (!partials) {
+        logPrint(L_ZERO, 1, "Allocation of partial results for list [%p] failed\n", list);
+        return LIST_MEMORY_ERROR;
+    }
+    for (unsigned chunk = 0; chunk < chunks; chunk++)
+        memcpy(partials + chunk * stride, identity, resultSize);
+
+    enum listStatus status = listRunChunks(list, order, chunks,
+        [list, partials, stride, step, ctx](unsigned chunk, listIterator_t iter) {
+            step(partials + chunk * stride, listDataOf(list, iter), ctx);
+        });
+
+    if (status == LIST_SUCCESS) {
+        // partials are combined in chunk order, so IN_ORDER reduction needs only associativity
+        memcpy(result, partials, resultSize);
+        for (unsigned chunk = 1; chunk < chunks; chunk++)
+            combine(result, partials + chunk * stride, ctx);
+    }
+
+    free(partials);
+    return status;
+}
@@ -0,0 +1,484 @@
+/// @file
+/// @brief Shared node pool for many small lists
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "error_debug.h"
+#include "logger.h"
+#include "cList.h"
+#include "cListPool.h"
+
+#if defined(LIST_VERIFICATION) && !defined(NDEBUG)
+/// @brief Verify list of pool, lists are small so full check is cheap
+# define POOL_LIST_ASSERT(list, ERR_VALUE)                                                          \
+    do {                                                                                            \
+        enum listStatus status = poolListVerify(list);                                              \
+        if (status != LIST_SUCCESS) {                                                               \
+            logPrint(L_ZERO, 1, "<h2>%s:%d, %s\n", __FILE__, __LINE__, __PRETTY_FUNCTION__);        \
+            logPrint(L_ZERO, 1, "Pool list[%p] error occurred. Error code = %d</h2>\n", list, status); \
+            return ERR_VALUE;                                                                       \
+        }                                                                                           \
+    } while(0)
+#else
+# define POOL_LIST_ASSERT(list, ERR_VALUE)
+#endif
+
+/// @brief Check if node doesn't belong to any list, iter must be in [1, reserved]
+static bool poolNodeIsFree(const listPool_t *pool, listIterator_t iter) {
+    return iter >= pool->untouched || pool->prev[iter] == INVALID_LIST_IT;
+}
+
+/// @brief Check if iter is node taken by some list
+static bool poolNodeIsElement(const listPool_t *pool, listIterator_t iter) {
+    return iter > NULL_LIST_IT && iter <= pool->reserved && !poolNodeIsFree(pool, iter);
+}
+
+/*! @brief Check that run [first, last] of linked nodes belongs to list
+    Nodes of all lists of pool share link arrays, so list is told by the end that run leads to.
+    Run is walked outwards from both sides at once, O(distance to the nearer end of list)
+!*/
+static bool poolRunBelongsTo(const poolList_t *list, listIterator_t first, listIterator_t last) {
+    const listPool_t *pool = list->pool;
+    // broken links can't make it loop, list has no more than size nodes outside of run
+    for (int32_t step = 0; step <= list->size; step++) {
+        if (pool->prev[first] == NULL_LIST_IT)
+            return first == list->first;
+        if (pool->next[last] == NULL_LIST_IT)
+            return last == list->last;
+        first = pool->prev[first];
+        last  = pool->next[last];
+    }
+    return false;
+}
+
+/// @brief Report failed reallocation, arrays that were already grown stay bigger, pool itself isn't changed
+static enum listStatus poolAllocFailed(const listPool_t *pool) {
+    logPrint(L_ZERO, 1, "Reallocation of pool [%p] failed\n", pool);
+    return LIST_MEMORY_ERROR;
+}
+
+/// @brief Grow arrays of pool to newReserved nodes, new nodes join untouched region
+static enum listStatus poolResize(listPool_t *pool, int32_t newReserved) {
+    logPrint(L_DEBUG, 0, "Reallocating pool [%p]: %d -> %d\n", pool, pool->reserved, newReserved);
+
+    // + 1 because node 0 is shared terminator
+    size_t newCapacity = (size_t) newReserved + 1;
+
+    int32_t *next = (int32_t *) realloc(pool->next, newCapacity * sizeof(int32_t));
+    if (!next)
+        return poolAllocFailed(pool);
+    pool->next = next;
+
+    int32_t *prev = (int32_t *) realloc(pool->prev, newCapacity * sizeof(int32_t));
+    if (!prev)
+        return poolAllocFailed(pool);
+    pool->prev = prev;
+
+    void *data = realloc(pool->data, newCapacity * pool->elemSize);
+    if (!data)
+        return poolAllocFailed(pool);
+    pool->data = data;
+
+    pool->reserved = newReserved;
+    return LIST_SUCCESS;
+}
+
+/// @brief Grow pool according to its growth policy, but at least to minReserved nodes
+static enum listStatus poolRealloc(listPool_t *pool, int64_t minReserved) {
+    int64_t reserved    = pool->reserved;
+    int64_t newReserved = listNextCapacity(&pool->growth, reserved, minReserved, LIST_MAX_RESERVED);
+
+    if (newReserved < minReserved || newReserved <= reserved) {
+        logPrint(L_ZERO, 1, "Pool [%p] can't grow to %lld nodes, maximum capacity is %d\n",
+                            pool, (long long) minReserved, LIST_MAX_RESERVED);
+        return LIST_SIZE_ERROR;
+    }
+    return poolResize(pool, (int32_t) newReserved);
+}
+
+/// @brief Take node from free sequence first, then from untouched region, pool grows if needed
+/// @return NULL_LIST_IT if pool can't grow
+static listIterator_t poolTakeNode(listPool_t *pool) {
+    if (pool->free != NULL_LIST_IT) {
+        listIterator_t node = pool->free;
+        pool->free = pool->next[node];
+        return node;
+    }
+    if (pool->untouched > pool->reserved && poolRealloc(pool, (int64_t) pool->reserved + 1) != LIST_SUCCESS)
+        return NULL_LIST_IT;
+    return pool->untouched++;
+}
+
+/// @brief Link chain first..last (already linked by next/prev inside) after iter of list
+static void poolLinkRange(poolList_t *list, listIterator_t iter, listIterator_t first, listIterator_t last) {
+    listPool_t *pool = list->pool;
+    listIterator_t nextNode = (iter == NULL_LIST_IT) ? list->first : pool->next[iter];
+
+    pool->prev[first] = iter;
+    pool->next[last]  = nextNode;
+
+    if (iter == NULL_LIST_IT)
+        list->first = first;
+    else
+        pool->next[iter] = first;
+
+    if (nextNode == NULL_LIST_IT)
+        list->last = last;
+    else
+        pool->prev[nextNode] = last;
+}
+
+/// @brief Unlink chain first..last from list, links inside chain are kept
+static void poolUnlinkRange(poolList_t *list, listIterator_t first, listIterator_t last) {
+    listPool_t *pool = list->pool;
+    listIterator_t prevNode = pool->prev[first],
+                   nextNode = pool->next[last];
+
+    if (prevNode == NULL_LIST_IT)
+        list->first = nextNode;
+    else
+        pool->next[prevNode] = nextNode;
+
+    if (nextNode == NULL_LIST_IT)
+        list->last = prevNode;
+    else
+        pool->prev[nextNode] = prevNode;
+}
+
+enum listStatus listPoolCtor(listPool_t *pool, size_t elemSize) {
+    MY_ASSERT(pool, exit(LIST_NULL_PTR_ERROR));
+    logPrint(L_DEBUG, 0, "Constructing pool [%p]\n", pool);
+
+    pool->elemSize = elemSize;
+    pool->next = NULL;
+    pool->prev = NULL;
+    pool->data = NULL;
+    pool->reserved = 0;
+    pool->used     = 0;
+    pool->growth   = LIST_DEFAULT_GROWTH;
+
+    if (poolResize(pool, (int32_t) MIN_LIST_RESERVED) != LIST_SUCCESS) {
+        listPoolDtor(pool);
+        return LIST_MEMORY_ERROR;
+    }
+
+    // node 0 isn't element of any list, its links are never used
+    pool->next[0] = NULL_LIST_IT;
+    pool->prev[0] = NULL_LIST_IT;
+    pool->free      = NULL_LIST_IT;
+    pool->untouched = 1;
+
+    return LIST_SUCCESS;
+}
+
+enum listStatus listPoolDtor(listPool_t *pool) {
+    MY_ASSERT(pool, exit(LIST_NULL_PTR_ERROR));
+    logPrint(L_DEBUG, 0, "Destructing pool [%p]\n", pool);
+
+    free(pool->next);
+    free(pool->prev);
+    free(pool->data);
+    pool->next = NULL;
+    pool->prev = NULL;
+    pool->data = NULL;
+    return LIST_SUCCESS;
+}
+
+enum listStatus listPoolReserve(listPool_t *pool, int32_t reserved) {
+    MY_ASSERT(pool, exit(LIST_NULL_PTR_ERROR));
+
+    if (reserved < 0 || reserved > LIST_MAX_RESERVED) {
+        logPrint(L_ZERO, 1, "Bad capacity %d requested for pool [%p]\n", reserved, pool);
+        return LIST_SIZE_ERROR;
+    }
+    if (reserved <= pool->reserved)
+        return LIST_SUCCESS;
+    return poolResize(pool, reserved);
+}
+
+enum listStatus listPoolSetGrowthPolicy(listPool_t *pool, listGrowthPolicy_t policy) {
+    MY_ASSERT(pool, exit(LIST_NULL_PTR_ERROR));
+
+    if (!(policy.factor >= 1) || policy.step < 0 || policy.maxStep < 0) {
+        logPrint(L_ZERO, 1, "Bad growth policy of pool [%p]: factor = %g, step = %d, maxStep = %d\n",
+                            pool, policy.factor, policy.step, policy.maxStep);
+        return LIST_ERROR;
+    }
+    pool->growth = policy;
+    return LIST_SUCCESS;
+}
+
+enum listStatus listPoolVerify(listPool_t *pool) {
+    MY_ASSERT(pool, exit(LIST_NULL_PTR_ERROR));
+
+    if (!pool->next || !pool->prev || !pool->data) {
+        logPrint(L_ZERO, 1, "Arrays of pool [%p] aren't allocated\n", pool);
+        return LIST_MEMORY_ERROR;
+    }
+    if (pool->elemSize == 0 || pool->reserved < 0 || pool->untouched < 1 || pool->untouched > pool->reserved + 1 ||
+        pool->used < 0 || pool->used >= pool->untouched) {
+        logPrint(L_ZERO, 1, "Bad header of pool [%p]: reserved = %d, used = %d, untouched = %d\n",
+                            pool, pool->reserved, pool->used, pool->untouched);
+        return LIST_SIZE_ERROR;
+    }
+
+    int32_t freeCount = 0;
+    for (listIterator_t iter = pool->free; iter != NULL_LIST_IT; iter = pool->next[iter], freeCount++) {
+        if (iter < 0 || iter >= pool->untouched || pool->prev[iter] != INVALID_LIST_IT || freeCount >= pool->reserved) {
+            logPrint(L_ZERO, 1, "Wrong linking in free sequence of pool [%p]: node %d\n", pool, iter);
+            return LIST_FREE_LINK_ERROR;
+        }
+    }
+    // nodes taken by lists and free sequence together cover everything before untouched region
+    if (freeCount + pool->used != pool->untouched - 1) {
+        logPrint(L_ZERO, 1, "Pool [%p] lost nodes: %d free + %d used != %d\n",
+                            pool, freeCount, pool->used, pool->untouched - 1);
+        return LIST_FREE_LINK_ERROR;
+    }
+    return LIST_SUCCESS;
+}
+
+enum listStatus poolListCtor(poolList_t *list, listPool_t *pool) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(pool, exit(LIST_NULL_PTR_ERROR));
+
+    list->pool  = pool;
+    list->first = NULL_LIST_IT;
+    list->last  = NULL_LIST_IT;
+    list->size  = 0;
+    return LIST_SUCCESS;
+}
+
+enum listStatus poolListClear(poolList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    POOL_LIST_ASSERT(list, status);
+
+    if (list->size == 0)
+        return LIST_SUCCESS;
+
+    listPool_t *pool = list->pool;
+    for (listIterator_t iter = list->first; iter != NULL_LIST_IT; iter = pool->next[iter])
+        pool->prev[iter] = INVALID_LIST_IT;
+
+    // nodes are already linked by next, so whole list is spliced into free sequence
+    pool->next[list->last] = pool->free;
+    pool->free  = list->first;
+    pool->used -= list->size;
+
+    list->first = NULL_LIST_IT;
+    list->last  = NULL_LIST_IT;
+    list->size  = 0;
+    return LIST_SUCCESS;
+}
+
+enum listStatus poolListVerify(poolList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    listPool_t *pool = list->pool;
+
+    if (!pool || !pool->next || !pool->prev) {
+        logPrint(L_ZERO, 1, "Pool of list [%p] isn't constructed\n", list);
+        return LIST_MEMORY_ERROR;
+    }
+    if (list->size < 0 || list->size > pool->used) {
+        logPrint(L_ZERO, 1, "Bad size of pool list [%p]: %d, pool has %d used nodes\n", list, list->size, pool->used);
+        return LIST_SIZE_ERROR;
+    }
+    if ((list->size == 0) != (list->first == NULL_LIST_IT) || (list->size == 0) != (list->last == NULL_LIST_IT)) {
+        logPrint(L_ZERO, 1, "Empty pool list [%p] has elements or vice versa\n", list);
+        return LIST_HEAD_ERROR;
+    }
+
+    int32_t visited = 0;
+    listIterator_t prevNode = NULL_LIST_IT;
+    for (listIterator_t iter = list->first; iter != NULL_LIST_IT; iter = pool->next[iter], visited++) {
+        if (visited >= list->size || !poolNodeIsElement(pool, iter)) {
+            logPrint(L_ZERO, 1, "Wrong linking in pool list [%p]: node %d\n", list, iter);
+            return LIST_NEXT_LINK_ERROR;
+        }
+        if (pool->prev[iter] != prevNode) {
+            logPrint(L_ZERO, 1, "prev[%d] = %d != %d in pool list [%p]\n", iter, pool->prev[iter], prevNode, list);
+            return LIST_PREV_LINK_ERROR;
+        }
+        prevNode = iter;
+    }
+    if (visited != list->size || prevNode != list->last) {
+        logPrint(L_ZERO, 1, "Pool list [%p] has %d elements ending with %d, expected %d ending with %d\n",
+                            list, visited, prevNode, list->size, list->last);
+        return LIST_TALE_ERROR;
+    }
+    return LIST_SUCCESS;
+}
+
+listIterator_t poolListFront(poolList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    return list->first;
+}
+
+listIterator_t poolListBack(poolList_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    return list->last;
+}
+
+listIterator_t poolListNext(poolList_t *list, listIterator_t iter) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    if (!poolNodeIsElement(list->pool, iter)) {
+        logPrint(L_DEBUG, 0, "Invalid listIterator_t passed in poolListNext: %d\n", iter);
+        return INVALID_LIST_IT;
+    }
+    return list->pool->next[iter];
+}
+
+listIterator_t poolListPrev(poolList_t *list, listIterator_t iter) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    if (!poolNodeIsElement(list->pool, iter)) {
+        logPrint(L_DEBUG, 0, "Invalid listIterator_t passed in poolListPrev: %d\n", iter);
+        return INVALID_LIST_IT;
+    }
+    return list->pool->prev[iter];
+}
+
+void *poolListGet(poolList_t *list, listIterator_t iter) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    if (!poolNodeIsElement(list->pool, iter))
+        return NULL;
+    return poolDataOf(list->pool, iter);
+}
+
+listIterator_t poolListInsertAfter(poolList_t *list, listIterator_t iter, const void *elem) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(elem, exit(LIST_NULL_PTR_ERROR));
+    POOL_LIST_ASSERT(list, INVALID_LIST_IT);
+
+    listPool_t *pool = list->pool;
+    if (iter != NULL_LIST_IT && !poolNodeIsElement(pool, iter)) {
+        logPrint(L_DEBUG, 0, "Invalid listIterator_t passed in poolListInsertAfter: %d\n"
+                             "For pool[%p] maximum iterator is %d\n", iter, pool, pool->reserved);
+        return INVALID_LIST_IT;
+    }
+
+    listIterator_t node = poolTakeNode(pool);
+    if (node == NULL_LIST_IT)
+        return INVALID_LIST_IT;
+
+    memcpy(poolDataOf(pool, node), elem, pool->elemSize);
+    poolLinkRange(list, iter, node, node);
+    list->size++;
+    pool->used++;
+
+    POOL_LIST_ASSERT(list, INVALID_LIST_IT);
+    return node;
+}
+
+listIterator_t poolListPushFront(poolList_t *list, const void *elem) {
+    return poolListInsertAfter(list, NULL_LIST_IT, elem);
+}
+
+listIterator_t poolListPushBack(poolList_t *list, const void *elem) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    return poolListInsertAfter(list, list->last, elem);
+}
+
+enum listStatus poolListRemove(poolList_t *list, listIterator_t iter) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    POOL_LIST_ASSERT(list, status);
+
+    listPool_t *pool = list->pool;
+    if (list->size == 0 || !poolNodeIsElement(pool, iter)) {
+        logPrint(L_DEBUG, 0, "Attempt to remove node %d which isn't element of pool list[%p]\n", iter, list);
+        return LIST_ERROR;
+    }
+
+    poolUnlinkRange(list, iter, iter);
+    pool->prev[iter] = INVALID_LIST_IT;
+    pool->next[iter] = pool->free;
+    pool->free = iter;
+    list->size--;
+    pool->used--;
+
+    POOL_LIST_ASSERT(list, status);
+    return LIST_SUCCESS;
+}
+
+enum listStatus poolListSpliceAfter(poolList_t *dest, listIterator_t iter,
+                                    poolList_t *src, listIterator_t first, listIterator_t last) {
+    MY_ASSERT(dest, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(src,  exit(LIST_NULL_PTR_ERROR));
+    POOL_LIST_ASSERT(dest, status);
+    POOL_LIST_ASSERT(src,  status);
+
+    listPool_t *pool = src->pool;
+    if (dest->pool != pool) {
+        logPrint(L_ZERO, 1, "Pool lists [%p] and [%p] belong to different pools\n", dest, src);
+        return LIST_ERROR;
+    }
+    if (!poolNodeIsElement(pool, first) || !poolNodeIsElement(pool, last) ||
+        (iter != NULL_LIST_IT && !poolNodeIsElement(pool, iter))) {
+        logPrint(L_DEBUG, 0, "Invalid range [%d, %d] or position %d passed in poolListSpliceAfter\n", first, last, iter);
+        return LIST_ERROR;
+    }
+
+    // range is checked and counted before anything is changed
+    int32_t count = 1;
+    for (listIterator_t node = first; ; node = pool->next[node], count++) {
+        if (src == dest && node == iter && node != last) {
+            logPrint(L_DEBUG, 0, "Position %d is inside spliced range [%d, %d]\n", iter, first, last);
+            return LIST_ERROR;
+        }
+        if (node == last)
+            break;
+        if (pool->next[node] == NULL_LIST_IT) {
+            logPrint(L_DEBUG, 0, "Element %d doesn't follow %d in pool list[%p]\n", last, first, src);
+            return LIST_ERROR;
+        }
+    }
+    // nodes of other list of pool would be relinked silently, so ownership is checked too
+    if (!poolRunBelongsTo(src, first, last) || (iter != NULL_LIST_IT && !poolRunBelongsTo(dest, iter, iter))) {
+        logPrint(L_DEBUG, 0, "Range [%d, %d] isn't in pool list[%p] or position %d isn't in pool list[%p]\n",
+                             first, last, src, iter, dest);
+        return LIST_ERROR;
+    }
+    if (src == dest && (iter == last || iter == pool->prev[first]))
+        return LIST_SUCCESS;
+
+    poolUnlinkRange(src, first, last);
+    src->size -= count;
+    poolLinkRange(dest, iter, first, last);
+    dest->size += count;
+
+    POOL_LIST_ASSERT(dest, status);
+    POOL_LIST_ASSERT(src,  status);
+    return LIST_SUCCESS;
+}
+
+enum listStatus poolListSpliceAllAfter(poolList_t *dest, listIterator_t iter, poolList_t *src) {
+    MY_ASSERT(dest, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(src,  exit(LIST_NULL_PTR_ERROR));
+    POOL_LIST_ASSERT(dest, status);
+    POOL_LIST_ASSERT(src,  status);
+
+    if (dest->pool != src->pool || dest == src) {
+        logPrint(L_ZERO, 1, "Pool list [%p] can't be spliced into [%p]\n", src, dest);
+        return LIST_ERROR;
+    }
+    if (iter != NULL_LIST_IT && (!poolNodeIsElement(dest->pool, iter) || !poolRunBelongsTo(dest, iter, iter))) {
+        logPrint(L_DEBUG, 0, "Invalid listIterator_t passed in poolListSpliceAllAfter: %d\n", iter);
+        return LIST_ERROR;
+    }
+    if (src->size == 0)
+        return LIST_SUCCESS;
+
+    poolLinkRange(dest, iter, src->first, src->last);
+    dest->size += src->size;
+
+    src->first = NULL_LIST_IT;
+    src->last  = NULL_LIST_IT;
+    src->size  = 0;
+
+    POOL_LIST_ASSERT(dest, status);
+    return LIST_SUCCESS;
+}
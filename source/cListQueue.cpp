@@ -0,0 +1,230 @@
+/// @file
+/// @brief Lock-free SPSC / MPSC queue on preallocated index-linked nodes
+/// Hot path doesn't log: logger isn't thread-safe
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <atomic>
+
+#include "error_debug.h"
+#include "logger.h"
+#include "cList.h"
+#include "cListQueue.h"
+
+// next array is allocated by calloc, so atomics must be plain integers in memory
+static_assert(std::atomic<int32_t>::is_always_lock_free,  "int32_t atomics must be lock-free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "uint64_t atomics must be lock-free");
+static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t), "atomic index must have size of index");
+
+/// Dummy node of empty queue
+const int32_t LIST_QUEUE_FIRST_DUMMY = 1;
+
+static inline void *listQueueDataOf(const listQueue_t *queue, int32_t node) {
+    return (char *) queue->data + queue->elemSize * (size_t) node;
+}
+
+static inline int32_t listQueueTagIndex(uint64_t tagged) {
+    return (int32_t) (tagged & UINT32_MAX);
+}
+
+/// @brief Tagged value with next version, version changes on every update of free stack
+static inline uint64_t listQueueRetag(uint64_t old, int32_t node) {
+    return (((old >> 32) + 1) << 32) | (uint32_t) node;
+}
+
+/// @brief MPSC: take node from free stack, NULL_LIST_IT if there is none
+static int32_t listQueuePopFree(listQueue_t *queue) {
+    uint64_t top = queue->freeHead.load(std::memory_order_acquire);
+    while (true) {
+        int32_t node = listQueueTagIndex(top);
+        if (node == NULL_LIST_IT)
+            return NULL_LIST_IT;
+
+        // link may be stale if node was taken meanwhile, then version differs and CAS fails
+        int32_t nextNode = queue->next[node].load(std::memory_order_relaxed);
+        if (queue->freeHead.compare_exchange_weak(top, listQueueRetag(top, nextNode),
+                                                  std::memory_order_acquire, std::memory_order_acquire))
+            return node;
+    }
+}
+
+/// @brief MPSC: return node to free stack, release makes its payload reads visible to next owner
+static void listQueuePushFree(listQueue_t *queue, int32_t node) {
+    uint64_t top = queue->freeHead.load(std::memory_order_relaxed);
+    do {
+        queue->next[node].store(listQueueTagIndex(top), std::memory_order_relaxed);
+    } while (!queue->freeHead.compare_exchange_weak(top, listQueueRetag(top, node),
+                                                    std::memory_order_release, std::memory_order_relaxed));
+}
+
+/// @brief SPSC: take node passed by consumer or never used one, NULL_LIST_IT if queue is full
+static int32_t listQueueTakeSpsc(listQueue_t *queue) {
+    // acquire of head covers every node before it, so stale headSeen is still safe
+    if (queue->firstFree == queue->headSeen)
+        queue->headSeen = queue->head.load(std::memory_order_acquire);
+    if (queue->firstFree != queue->headSeen) {
+        int32_t node = queue->firstFree;
+        queue->firstFree = queue->next[node].load(std::memory_order_relaxed);
+        return node;
+    }
+    if (queue->untouched <= queue->capacity + 1)
+        return queue->untouched++;
+    return NULL_LIST_IT;
+}
+
+enum listStatus listQueueCtor(listQueue_t *queue, size_t elemSize, int32_t capacity, enum listQueueMode mode) {
+    MY_ASSERT(queue, exit(LIST_NULL_PTR_ERROR));
+    logPrint(L_DEBUG, 0, "Constructing queue [%p]\n", queue);
+
+    if (capacity < 1 || capacity >= LIST_MAX_RESERVED || elemSize == 0) {
+        logPrint(L_ZERO, 1, "Bad capacity %d or element size %zu of queue [%p]\n", capacity, elemSize, queue);
+        return LIST_SIZE_ERROR;
+    }
+
+    // node 0 terminates sequences, capacity elements and one dummy node follow it
+    size_t nodeCount = (size_t) capacity + 2;
+    queue->elemSize = elemSize;
+    queue->capacity = capacity;
+    queue->mode     = mode;
+    queue->next = (std::atomic<int32_t> *) calloc(nodeCount, sizeof(std::atomic<int32_t>));
+    queue->data = calloc(nodeCount, elemSize);
+    if (!queue->next || !queue->data) {
+        logPrint(L_ZERO, 1, "Allocation of queue [%p] storage failed\n", queue);
+        listQueueDtor(queue);
+        return LIST_MEMORY_ERROR;
+    }
+
+    queue->head.store(LIST_QUEUE_FIRST_DUMMY, std::memory_order_relaxed);
+    queue->tail.store(LIST_QUEUE_FIRST_DUMMY, std::memory_order_relaxed);
+    queue->firstFree = LIST_QUEUE_FIRST_DUMMY;
+    queue->headSeen  = LIST_QUEUE_FIRST_DUMMY;
+    queue->untouched = LIST_QUEUE_FIRST_DUMMY + 1;
+    queue->freeHead.store(NULL_LIST_IT, std::memory_order_relaxed);
+
+    // MPSC producers can't share untouched counter cheaply, so all nodes start in free stack
+    if (mode == LIST_QUEUE_MPSC) {
+        for (int32_t node = LIST_QUEUE_FIRST_DUMMY + 1; node <= capacity; node++)
+            queue->next[node].store(node + 1, std::memory_order_relaxed);
+        queue->next[capacity + 1].store(NULL_LIST_IT, std::memory_order_relaxed);
+        queue->freeHead.store(LIST_QUEUE_FIRST_DUMMY + 1, std::memory_order_relaxed);
+        queue->untouched = capacity + 2;
+    }
+
+    return LIST_SUCCESS;
+}
+
+enum listStatus listQueueDtor(listQueue_t *queue) {
+    MY_ASSERT(queue, exit(LIST_NULL_PTR_ERROR));
+    logPrint(L_DEBUG, 0, "Destructing queue [%p]\n", queue);
+
+    free(queue->next);
+    free(queue->data);
+    queue->next = NULL;
+    queue->data = NULL;
+    return LIST_SUCCESS;
+}
+
+bool listQueueTryPush(listQueue_t *queue, const void *elem) {
+    MY_ASSERT(queue, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(elem,  exit(LIST_NULL_PTR_ERROR));
+
+    int32_t node = (queue->mode == LIST_QUEUE_MPSC) ? listQueuePopFree(queue) : listQueueTakeSpsc(queue);
+    if (node == NULL_LIST_IT)
+        return false;
+
+    memcpy(listQueueDataOf(queue, node), elem, queue->elemSize);
+    queue->next[node].store(NULL_LIST_IT, std::memory_order_relaxed);
+
+    // release store of link publishes payload to consumer
+    if (queue->mode == LIST_QUEUE_MPSC) {
+        int32_t prevNode = queue->tail.exchange(node, std::memory_order_acq_rel);
+        queue->next[prevNode].store(node, std::memory_order_release);
+    } else {
+        int32_t prevNode = queue->tail.load(std::memory_order_relaxed);
+        queue->next[prevNode].store(node, std::memory_order_release);
+        queue->tail.store(node, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool listQueueTryPop(listQueue_t *queue, void *elem) {
+    MY_ASSERT(queue, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(elem,  exit(LIST_NULL_PTR_ERROR));
+
+    int32_t dummy = queue->head.load(std::memory_order_relaxed);
+    int32_t first = queue->next[dummy].load(std::memory_order_acquire);
+    if (first == NULL_LIST_IT)
+        return false;
+
+    // first element becomes new dummy, its payload isn't needed anymore
+    memcpy(elem, listQueueDataOf(queue, first), queue->elemSize);
+    if (queue->mode == LIST_QUEUE_MPSC) {
+        queue->head.store(first, std::memory_order_relaxed);
+        listQueuePushFree(queue, dummy);
+    } else {
+        // release lets producer reuse old dummy only after payload is copied
+        queue->head.store(first, std::memory_order_release);
+    }
+    return true;
+}
+
+enum listStatus listQueueVerify(listQueue_t *queue) {
+    MY_ASSERT(queue, exit(LIST_NULL_PTR_ERROR));
+
+    if (!queue->next || !queue->data) {
+        logPrint(L_ZERO, 1, "Storage of queue [%p] isn't allocated\n", queue);
+        return LIST_MEMORY_ERROR;
+    }
+    const int32_t lastNode = queue->capacity + 1;
+    if (queue->capacity < 1 || queue->untouched < LIST_QUEUE_FIRST_DUMMY + 1 || queue->untouched > lastNode + 1) {
+        logPrint(L_ZERO, 1, "Bad header of queue [%p]: capacity = %d, untouched = %d\n",
+                            queue, queue->capacity, queue->untouched);
+        return LIST_SIZE_ERROR;
+    }
+
+    // queue sequence from dummy head to tail
+    int32_t nodes = 0, node = queue->head.load(std::memory_order_relaxed), last = NULL_LIST_IT;
+    for (; node != NULL_LIST_IT; last = node, node = queue->next[node].load(std::memory_order_relaxed), nodes++) {
+        if (node < LIST_QUEUE_FIRST_DUMMY || node >= queue->untouched || nodes > queue->capacity) {
+            logPrint(L_ZERO, 1, "Wrong linking in queue [%p]: node %d\n", queue, node);
+            return LIST_NEXT_LINK_ERROR;
+        }
+    }
+    if (last != queue->tail.load(std::memory_order_relaxed)) {
+        logPrint(L_ZERO, 1, "Queue [%p] ends with %d, but tail is %d\n", queue, last, queue->tail.load());
+        return LIST_TALE_ERROR;
+    }
+
+    // free nodes: stack in MPSC mode, nodes passed by consumer in SPSC mode
+    int32_t freeNodes = 0;
+    if (queue->mode == LIST_QUEUE_MPSC) {
+        node = listQueueTagIndex(queue->freeHead.load(std::memory_order_relaxed));
+        for (; node != NULL_LIST_IT; node = queue->next[node].load(std::memory_order_relaxed), freeNodes++) {
+            if (node < LIST_QUEUE_FIRST_DUMMY || node > lastNode || freeNodes > queue->capacity) {
+                logPrint(L_ZERO, 1, "Wrong linking in free stack of queue [%p]: node %d\n", queue, node);
+                return LIST_FREE_LINK_ERROR;
+            }
+        }
+    } else {
+        node = queue->firstFree;
+        for (; node != queue->head.load(std::memory_order_relaxed);
+               node = queue->next[node].load(std::memory_order_relaxed), freeNodes++) {
+            if (node < LIST_QUEUE_FIRST_DUMMY || node >= queue->untouched || freeNodes > queue->capacity) {
+                logPrint(L_ZERO, 1, "Wrong linking of passed nodes of queue [%p]: node %d\n", queue, node);
+                return LIST_FREE_LINK_ERROR;
+            }
+        }
+    }
+
+    int32_t untouched = lastNode + 1 - queue->untouched;
+    if (nodes + freeNodes + untouched != lastNode) {
+        logPrint(L_ZERO, 1, "Queue [%p] lost nodes: %d queued + %d free + %d untouched != %d\n",
+                            queue, nodes, freeNodes, untouched, lastNode);
+        return LIST_FREE_LINK_ERROR;
+    }
+    return LIST_SUCCESS;
+}
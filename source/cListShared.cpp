@@ -0,0 +1,141 @@
+/// @file
+/// @brief Thread-safe cList_t with concurrent readers and exclusive writers
+/// Readers don't call cList_t functions: they verify list and update counters
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <mutex>
+#include <shared_mutex>
+
+#include "error_debug.h"
+#include "logger.h"
+#include "cList.h"
+#include "cListIndex.h"
+#include "cListShared.h"
+
+typedef std::unique_lock<std::shared_mutex> listWriteLock_t;
+typedef std::shared_lock<std::shared_mutex> listReadLock_t;
+
+/// @brief Check that iter points to element, no verification and logging
+static bool listSharedIsElement(const cList_t *list, listIterator_t iter) {
+    return iter > NULL_LIST_IT && iter <= list->reserved && !listSlotIsFree(list, iter);
+}
+
+enum listStatus listSharedCtor(listShared_t *shared, size_t elemSize, listPrintFunction_t sPrint,
+                               enum listLayout layout) {
+    MY_ASSERT(shared, exit(LIST_NULL_PTR_ERROR));
+    return listCtor(&shared->list, elemSize, sPrint, layout);
+}
+
+enum listStatus listSharedDtor(listShared_t *shared) {
+    MY_ASSERT(shared, exit(LIST_NULL_PTR_ERROR));
+    listWriteLock_t lock(shared->lock);
+    return listDtor(&shared->list);
+}
+
+listIterator_t listSharedPushBack(listShared_t *shared, const void *elem) {
+    MY_ASSERT(shared, exit(LIST_NULL_PTR_ERROR));
+    listWriteLock_t lock(shared->lock);
+    return listPushBack(&shared->list, elem);
+}
+
+listIterator_t listSharedPushFront(listShared_t *shared, const void *elem) {
+    MY_ASSERT(shared, exit(LIST_NULL_PTR_ERROR));
+    listWriteLock_t lock(shared->lock);
+    return listPushFront(&shared->list, elem);
+}
+
+listIterator_t listSharedInsertAfter(listShared_t *shared, listIterator_t iter, const void *elem) {
+    MY_ASSERT(shared, exit(LIST_NULL_PTR_ERROR));
+    listWriteLock_t lock(shared->lock);
+
+    // iterator may be stale, listInsertAfter would accept free slot
+    if (iter != NULL_LIST_IT && !listSharedIsElement(&shared->list, iter))
+        return INVALID_LIST_IT;
+    return listInsertAfter(&shared->list, iter, elem);
+}
+
+enum listStatus listSharedRemove(listShared_t *shared, listIterator_t iter) {
+    MY_ASSERT(shared, exit(LIST_NULL_PTR_ERROR));
+    listWriteLock_t lock(shared->lock);
+
+    if (!listSharedIsElement(&shared->list, iter))
+        return LIST_ERROR;
+    return listRemove(&shared->list, iter);
+}
+
+bool listSharedTryPopFront(listShared_t *shared, void *elem) {
+    MY_ASSERT(shared, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(elem,   exit(LIST_NULL_PTR_ERROR));
+    listWriteLock_t lock(shared->lock);
+
+    cList_t *list = &shared->list;
+    if (list->size == 0)
+        return false;
+
+    memcpy(elem, listDataOf(list, listNextOf(list, 0)), list->elemSize);
+    return listPopFront(list) != INVALID_LIST_IT;
+}
+
+enum listStatus listSharedUpdate(listShared_t *shared, listSharedUpdater_t updater, void *ctx) {
+    MY_ASSERT(shared,  exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(updater, exit(LIST_NULL_PTR_ERROR));
+    listWriteLock_t lock(shared->lock);
+    return updater(&shared->list, ctx);
+}
+
+int32_t listSharedSize(listShared_t *shared) {
+    MY_ASSERT(shared, exit(LIST_NULL_PTR_ERROR));
+    listReadLock_t lock(shared->lock);
+    return shared->list.size;
+}
+
+enum listStatus listSharedGet(listShared_t *shared, listIterator_t iter, void *elem) {
+    MY_ASSERT(shared, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(elem,   exit(LIST_NULL_PTR_ERROR));
+    listReadLock_t lock(shared->lock);
+
+    cList_t *list = &shared->list;
+    if (!listSharedIsElement(list, iter))
+        return LIST_ERROR;
+
+    memcpy(elem, listDataOf(list, iter), list->elemSize);
+    return LIST_SUCCESS;
+}
+
+listIterator_t listSharedFind(listShared_t *shared, const void *elem) {
+    MY_ASSERT(shared, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(elem,   exit(LIST_NULL_PTR_ERROR));
+    listReadLock_t lock(shared->lock);
+
+    // index lookup only reads buckets, so it is safe under shared lock
+    cList_t *list = &shared->list;
+    if (list->index) {
+        bool duplicates = false;
+        listIterator_t found = listIndexLookup(list, elem, &duplicates);
+        if (!duplicates)
+            return found;
+    }
+
+    listIterator_t iter = listNextOf(list, 0);
+    while (iter != NULL_LIST_IT && memcmp(listDataOf(list, iter), elem, list->elemSize) != 0)
+        iter = listNextOf(list, iter);
+
+    return (iter == NULL_LIST_IT) ? INVALID_LIST_IT : iter;
+}
+
+listIterator_t listSharedForEach(listShared_t *shared, listSharedVisitor_t visitor, void *ctx) {
+    MY_ASSERT(shared,  exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(visitor, exit(LIST_NULL_PTR_ERROR));
+    listReadLock_t lock(shared->lock);
+
+    cList_t *list = &shared->list;
+    for (listIterator_t iter = listNextOf(list, 0); iter != NULL_LIST_IT; iter = listNextOf(list, iter))
+        if (visitor(listDataOf(list, iter), iter, ctx))
+            return iter;
+    return NULL_LIST_IT;
+}
@@ -0,0 +1,595 @@
+/// @file
+/// @brief XOR-linked list with one link per slot, elements are reached by cursors
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <atomic>
+
+#include "error_debug.h"
+#include "logger.h"
+#include "cList.h"
+#include "cListXor.h"
+
+/// Size of buffer for printed payloads in dump
+const size_t LIST_XOR_BUFFER_SIZE = 100;
+
+#if defined(LIST_VERIFICATION) && !defined(NDEBUG)
+/// @brief Check list according to its verification level, cursor is the place that was touched
+# define LIST_XOR_ASSERT(list, cursor, ERR_VALUE)                                                   \
+    do {                                                                                            \
+        enum listStatus status = listXorCheck(list, cursor);                                        \
+        if (status != LIST_SUCCESS) {                                                               \
+            logPrint(L_ZERO, 1, "<h2>%s:%d, %s\n", __FILE__, __LINE__, __PRETTY_FUNCTION__);        \
+            logPrint(L_ZERO, 1, "Xor list[%p] error occurred. Error code = %d</h2>\n", list, status); \
+            LIST_XOR_DUMP(list, "assert failed");                                                   \
+            return ERR_VALUE;                                                                       \
+        }                                                                                           \
+    } while(0)
+#else
+# define LIST_XOR_ASSERT(list, cursor, ERR_VALUE)
+#endif
+
+/// @brief Cursor past the end without checks
+static listXorCursor_t listXorEndOf(const listXor_t *list) {
+    listXorCursor_t cursor = {list->link[0] ^ list->first, NULL_LIST_IT};
+    return cursor;
+}
+
+/// @brief Check if slot is NULL element or element of list
+static bool listXorIsNode(const listXor_t *list, listIterator_t iter) {
+    return iter >= 0 && iter < list->untouched && list->link[iter] >= 0;
+}
+
+/// @brief Check that slots of cursor are adjacent as far as their links can tell, O(1)
+static bool listXorCursorIsValid(const listXor_t *list, listXorCursor_t cursor) {
+    if (!listXorIsNode(list, cursor.prev) || !listXorIsNode(list, cursor.cur))
+        return false;
+    // only empty list has cursor with the same slots, NULL element is its own neighbour
+    if (cursor.prev == cursor.cur)
+        return list->size == 0;
+    return listXorIsNode(list, list->link[cursor.prev] ^ cursor.cur) &&
+           listXorIsNode(list, list->link[cursor.cur]  ^ cursor.prev);
+}
+
+/// @brief Log failed reallocation of list
+static enum listStatus listXorAllocFailed(const listXor_t *list) {
+    logPrint(L_ZERO, 1, "Reallocation of xor list [%p] failed\n", list);
+    return LIST_MEMORY_ERROR;
+}
+
+/// @brief Grow arrays of list to newReserved slots, new slots join untouched region
+static enum listStatus listXorResize(listXor_t *list, int32_t newReserved) {
+    logPrint(L_DEBUG, 0, "Reallocating xor list [%p]: %d -> %d\n", list, list->reserved, newReserved);
+
+    // + 1 because slot 0 is NULL element
+    size_t newCapacity = (size_t) newReserved + 1;
+
+    // array that was already grown stays bigger on failure, list itself isn't changed
+    int32_t *link = (int32_t *) realloc(list->link, newCapacity * sizeof(int32_t));
+    if (!link)
+        return listXorAllocFailed(list);
+    list->link = link;
+
+    void *data = realloc(list->data, newCapacity * list->elemSize);
+    if (!data)
+        return listXorAllocFailed(list);
+    list->data = data;
+
+    list->reserved = newReserved;
+    return LIST_SUCCESS;
+}
+
+/// @brief Grow list according to its growth policy, but at least to minReserved slots
+static enum listStatus listXorRealloc(listXor_t *list, int64_t minReserved) {
+    int64_t reserved    = list->reserved;
+    int64_t newReserved = listNextCapacity(&list->growth, reserved, minReserved, LIST_MAX_RESERVED);
+
+    if (newReserved < minReserved || newReserved <= reserved) {
+        logPrint(L_ZERO, 1, "Xor list [%p] can't grow to %lld elements, maximum capacity is %d\n",
+                            list, (long long) minReserved, LIST_MAX_RESERVED);
+        return LIST_SIZE_ERROR;
+    }
+    return listXorResize(list, (int32_t) newReserved);
+}
+
+/// @brief Take slot from free sequence first, then from untouched region, list grows if needed
+/// @return NULL_LIST_IT if list can't grow
+static listIterator_t listXorTakeSlot(listXor_t *list) {
+    if (list->free != NULL_LIST_IT) {
+        listIterator_t slot = list->free;
+        list->free = ~list->link[slot];
+        return slot;
+    }
+    if (list->untouched > list->reserved && listXorRealloc(list, (int64_t) list->reserved + 1) != LIST_SUCCESS)
+        return NULL_LIST_IT;
+    return list->untouched++;
+}
+
+enum listStatus listXorCtor(listXor_t *list, size_t elemSize, listPrintFunction_t sPrint) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    logPrint(L_DEBUG, 0, "Constructing xor list [%p]\n", list);
+
+    list->elemSize = elemSize;
+    list->link     = NULL;
+    list->data     = NULL;
+    list->sPrint   = sPrint;
+    list->reserved = 0;
+    list->growth   = LIST_DEFAULT_GROWTH;
+
+    list->verifyLevel   = LIST_VERIFY_FULL;
+    list->verifyPeriod  = 0;
+    list->verifyCounter = 0;
+
+    if (elemSize == 0) {
+        logPrint(L_ZERO, 1, "Xor list [%p] can't have elements of size 0\n", list);
+        return LIST_SIZE_ERROR;
+    }
+    if (listXorResize(list, (int32_t) MIN_LIST_RESERVED) != LIST_SUCCESS) {
+        listXorDtor(list);
+        return LIST_MEMORY_ERROR;
+    }
+
+    // NULL element alone is a ring: first = last = 0
+    list->link[0]   = NULL_LIST_IT;
+    list->first     = NULL_LIST_IT;
+    list->size      = 0;
+    list->free      = NULL_LIST_IT;
+    list->untouched = 1;
+
+    LIST_XOR_ASSERT(list, listXorEndOf(list), status);
+    return LIST_SUCCESS;
+}
+
+enum listStatus listXorDtor(listXor_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    logPrint(L_DEBUG, 0, "Destructing xor list [%p]\n", list);
+
+    free(list->link);
+    free(list->data);
+    list->link = NULL;
+    list->data = NULL;
+    list->size = 0;
+    return LIST_SUCCESS;
+}
+
+enum listStatus listXorReserve(listXor_t *list, int32_t reserved) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    if (reserved < 0 || reserved > LIST_MAX_RESERVED) {
+        logPrint(L_ZERO, 1, "Bad capacity %d requested for xor list [%p]\n", reserved, list);
+        return LIST_SIZE_ERROR;
+    }
+    if (reserved <= list->reserved)
+        return LIST_SUCCESS;
+    return listXorResize(list, reserved);
+}
+
+enum listStatus listXorSetGrowthPolicy(listXor_t *list, listGrowthPolicy_t policy) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    if (!(policy.factor >= 1) || policy.step < 0 || policy.maxStep < 0) {
+        logPrint(L_ZERO, 1, "Bad growth policy of xor list [%p]: factor = %g, step = %d, maxStep = %d\n",
+                            list, policy.factor, policy.step, policy.maxStep);
+        return LIST_ERROR;
+    }
+    list->growth = policy;
+    return LIST_SUCCESS;
+}
+
+enum listStatus listXorClear(listXor_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    LIST_XOR_ASSERT(list, listXorEndOf(list), status);
+
+    // every slot before untouched region becomes free again, free sequence is rebuilt lazily
+    list->link[0]   = NULL_LIST_IT;
+    list->first     = NULL_LIST_IT;
+    list->size      = 0;
+    list->free      = NULL_LIST_IT;
+    list->untouched = 1;
+
+    LIST_XOR_ASSERT(list, listXorEndOf(list), status);
+    return LIST_SUCCESS;
+}
+
+/// @brief Check sizes and arrays of list, O(1)
+static enum listStatus listXorVerifyHeader(listXor_t *list) {
+    if (!list->link || !list->data) {
+        logPrint(L_ZERO, 1, "Arrays of xor list [%p] aren't allocated\n", list);
+        return LIST_MEMORY_ERROR;
+    }
+    if (list->elemSize == 0 || list->reserved < 0 || list->untouched < 1 || list->untouched > list->reserved + 1 ||
+        list->size < 0 || list->size >= list->untouched) {
+        logPrint(L_ZERO, 1, "Bad header of xor list [%p]: size = %d, reserved = %d, untouched = %d\n",
+                            list, list->size, list->reserved, list->untouched);
+        return LIST_SIZE_ERROR;
+    }
+    if ((list->size == 0) != (list->first == NULL_LIST_IT) || !listXorIsNode(list, list->first) ||
+        !listXorIsNode(list, list->link[0] ^ list->first)) {
+        logPrint(L_ZERO, 1, "Bad first element %d of xor list [%p], link[0] = %d\n", list->first, list, list->link[0]);
+        return LIST_HEAD_ERROR;
+    }
+    return LIST_SUCCESS;
+}
+
+enum listStatus listXorVerify(listXor_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    enum listStatus status = listXorVerifyHeader(list);
+    if (status != LIST_SUCCESS)
+        return status;
+
+    // every slot with non-negative link claims to be element
+    int32_t elements = 0;
+    for (listIterator_t slot = 1; slot < list->untouched; slot++)
+        if (list->link[slot] >= 0)
+            elements++;
+    if (elements != list->size) {
+        logPrint(L_ZERO, 1, "Xor list [%p] has %d slots with links, but size %d\n", list, elements, list->size);
+        return LIST_SIZE_ERROR;
+    }
+
+    // walk of size steps from first element must come back to NULL element from last one
+    listXorCursor_t cursor = {NULL_LIST_IT, list->first};
+    for (int32_t visited = 0; visited < list->size; visited++) {
+        if (cursor.cur == NULL_LIST_IT || !listXorIsNode(list, cursor.cur)) {
+            logPrint(L_ZERO, 1, "Wrong linking in xor list [%p]: slot %d at position %d\n", list, cursor.cur, visited);
+            return LIST_NEXT_LINK_ERROR;
+        }
+        listIterator_t nextSlot = list->link[cursor.cur] ^ cursor.prev;
+        cursor.prev = cursor.cur;
+        cursor.cur  = nextSlot;
+    }
+    if (cursor.cur != NULL_LIST_IT || (list->link[0] ^ cursor.prev) != list->first) {
+        logPrint(L_ZERO, 1, "Xor list [%p] doesn't end after %d elements: last = %d, next = %d, link[0] = %d\n",
+                            list, list->size, cursor.prev, cursor.cur, list->link[0]);
+        return LIST_TALE_ERROR;
+    }
+
+    int32_t freeCount = 0;
+    for (listIterator_t iter = list->free; iter != NULL_LIST_IT; iter = ~list->link[iter], freeCount++) {
+        if (iter <= NULL_LIST_IT || iter >= list->untouched || list->link[iter] >= 0 || freeCount >= list->reserved) {
+            logPrint(L_ZERO, 1, "Wrong linking in free sequence of xor list [%p]: slot %d\n", list, iter);
+            return LIST_FREE_LINK_ERROR;
+        }
+    }
+    // elements and free sequence together cover everything before untouched region
+    if (freeCount + list->size != list->untouched - 1) {
+        logPrint(L_ZERO, 1, "Xor list [%p] lost slots: %d free + %d elements != %d\n",
+                            list, freeCount, list->size, list->untouched - 1);
+        return LIST_FREE_ERROR;
+    }
+    return LIST_SUCCESS;
+}
+
+/// @brief O(1) checks of header and slots of cursor
+static enum listStatus listXorVerifyLocal(listXor_t *list, listXorCursor_t cursor) {
+    enum listStatus status = listXorVerifyHeader(list);
+    if (status != LIST_SUCCESS)
+        return status;
+
+    if (!listXorCursorIsValid(list, cursor)) {
+        logPrint(L_ZERO, 1, "Slots %d and %d of xor list [%p] aren't adjacent\n", cursor.prev, cursor.cur, list);
+        return LIST_NEXT_LINK_ERROR;
+    }
+    return LIST_SUCCESS;
+}
+
+enum listStatus listXorCheck(listXor_t *list, listXorCursor_t cursor) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    switch (list->verifyLevel) {
+    case LIST_VERIFY_OFF:
+        return LIST_SUCCESS;
+    case LIST_VERIFY_LOCAL:
+        return listXorVerifyLocal(list, cursor);
+    case LIST_VERIFY_SAMPLED:
+        if (++list->verifyCounter >= list->verifyPeriod) {
+            list->verifyCounter = 0;
+            return listXorVerify(list);
+        }
+        return listXorVerifyLocal(list, cursor);
+    case LIST_VERIFY_FULL:
+        return listXorVerify(list);
+    default:
+        logPrint(L_ZERO, 1, "Unknown verification level of xor list [%p]: %d\n", list, list->verifyLevel);
+        return LIST_ERROR;
+    }
+}
+
+enum listStatus listXorSetVerifyLevel(listXor_t *list, enum listVerifyLevel level, uint32_t period) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+
+    if (level == LIST_VERIFY_SAMPLED && period == 0) {
+        logPrint(L_ZERO, 1, "Sampled verification of xor list [%p] needs positive period\n", list);
+        return LIST_ERROR;
+    }
+
+    list->verifyLevel   = level;
+    list->verifyPeriod  = period;
+    list->verifyCounter = 0;
+    return LIST_SUCCESS;
+}
+
+enum listStatus listXorDump(listXor_t *list, const char *callMessage) {
+    const char *invColor        = "#00000000";
+    const char *freeColor       = "#AAAAAA";
+    const char *headColor       = "#6B9A6E";
+    const char *taleColor       = "#FF9E7B";
+    const char *goodEdgeColor   = "#2BA36C";
+    const char *badEdgeColor    = "#C3375A";
+    const char *headerColor     = "#C2B3A3";
+    const char *nullElemColor   = "#93AB9D";
+
+    // dumps of different lists may be made from different threads
+    static std::atomic<size_t> dumpCounter(0);
+    char buffer[LIST_XOR_BUFFER_SIZE] = "";
+
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    if (getLogLevel() < L_DEBUG)
+        return LIST_SUCCESS;
+    size_t imgNumber = dumpCounter.fetch_add(1);
+
+    logPrintColor(L_ZERO, "#FF0000", "#CCCCCC", "<h2>-------listXor_t [%p] dump--------</h2>\n", list);
+    logPrint(L_ZERO, 0, "<h2><b>Called with message: %s</b></h2>\n", callMessage);
+    if (!list->link) {
+        logPrint(L_ZERO, 0, "Arrays aren't allocated\n<hr>\n");
+        return LIST_SUCCESS;
+    }
+    system("mkdir -p logs/img logs/dot");
+
+    sprintf(buffer, "logs/dot/listXorDump_%zu.dot", imgNumber);
+    FILE *dotFile = fopen(buffer, "w");
+    if (!dotFile) {
+        logPrint(L_ZERO, 1, "Can't open %s for dump of xor list [%p]\n", buffer, list);
+        return LIST_FILE_ERROR;
+    }
+    fputs(  "digraph {\n"
+            "\trankdir = LR;\n"
+            "\tgraph [splines = ortho];\n",
+            dotFile);
+
+    listIterator_t last = list->link[0] ^ list->first;
+    fprintf(dotFile, "\tnode0 [shape=Mrecord, weight=10, label=\"NULL_ELEMENT | link = %d | (head) %d | (tale) %d\"",
+            list->link[0], list->first, last);
+    fprintf(dotFile, "\tcolor=\"%s\"];\n", nullElemColor);
+
+    fprintf(dotFile, "\tsubgraph cluster_Data {\n");
+    fprintf(dotFile, "\t\tlabel = \"Elements\";\n");
+    fprintf(dotFile, "\t\tbgcolor=\"#ccfdf9\";\n");
+
+    for (int32_t idx = 1; idx <= list->reserved; idx++) {
+        if (idx >= list->untouched) {
+            // links of untouched slots aren't initialized
+            fprintf(dotFile, "\t\tnode%d [shape=Mrecord, style=filled,weight=10, label=\"elem #%d | untouched\","
+                             "fillcolor=\"%s\"];\n", idx, idx, freeColor);
+            continue;
+        }
+
+        if (list->link[idx] < 0) {
+            fprintf(dotFile, "\t\tnode%d [shape=Mrecord, style=filled,weight=10, label=\"elem #%d | next free = %d\","
+                             "fillcolor=\"%s\"];\n", idx, idx, ~list->link[idx], freeColor);
+            continue;
+        }
+
+        if (list->sPrint)
+            list->sPrint(buffer, listXorDataOf(list, idx));
+        else
+            sprintf(buffer, "?");
+
+        const char *nodeColor = (idx == list->first) ? headColor :
+                                (idx == last)        ? taleColor :
+                                "white";
+        fprintf(dotFile, "\t\tnode%d [shape=Mrecord, style=filled,weight=10, label=\"elem #%d | link = %d | val = %s\","
+                         "fillcolor=\"%s\"];\n", idx, idx, list->link[idx], buffer, nodeColor);
+    }
+    fprintf(dotFile, "\t}\n");
+
+    fprintf(dotFile, "\tnodeHeader [fillcolor = \"%s\", shape=Mrecord, weight=10,"
+                     "label=\"Info | size = %d | capacity = %d | untouched from %d | links = %zu bytes per slot\"]\n",
+            headerColor, list->size, list->reserved, list->untouched, sizeof(int32_t));
+
+    fprintf(dotFile,
+        "\tlegend [shape=none, weight=10,"
+        "label = <"
+        "<table>"
+        "<tr><td>Color legend </td></tr>"
+        "<tr><td bgcolor=\"%s\">FREE</td></tr>"
+        "<tr><td bgcolor=\"%s\">Head</td></tr>"
+        "<tr><td bgcolor=\"%s\">Tale</td></tr>"
+        "<tr><td bgcolor=\"%s\">Decoded next</td></tr>"
+        "<tr><td bgcolor=\"%s\">Walk broke here</td></tr>"
+        "</table>>];\n", freeColor, headColor, taleColor, goodEdgeColor, badEdgeColor);
+
+    fprintf(dotFile, "\tlegend -> nodeHeader[color=\"%s\"];\n", invColor);
+
+    for (int32_t idx = 0; idx < list->reserved; idx++)
+        fprintf(dotFile, "\tnode%d -> node%d [color=\"%s\"];\n", idx, idx + 1, invColor);
+
+    // xor links have no direction by themselves, next edges are decoded by walk from NULL element
+    listXorCursor_t cursor = {NULL_LIST_IT, list->first};
+    for (int32_t step = 0; step < list->untouched; step++) {
+        if (!listXorIsNode(list, cursor.cur)) {
+            fprintf(dotFile, "\tnodeBad [color=\"%s\", label=\"Fantom element %d\"];\n"
+                             "\tnode%d -> nodeBad [constraint=false,style=bold,color=\"%s\"];\n",
+                             badEdgeColor, cursor.cur, cursor.prev, badEdgeColor);
+            break;
+        }
+        fprintf(dotFile, "\tnode%d -> node%d [constraint=false,style=bold,color=\"%s\"];\n",
+                cursor.prev, cursor.cur, goodEdgeColor);
+        if (cursor.cur == NULL_LIST_IT)
+            break;
+
+        listIterator_t nextSlot = list->link[cursor.cur] ^ cursor.prev;
+        cursor.prev = cursor.cur;
+        cursor.cur  = nextSlot;
+    }
+
+    fprintf(dotFile, "\tnodeFree [shape = Mrecord, style = filled, weight = 20, label = \"Free | next = %d\"];\n"
+                     "\tnodeFree -> node%d [weight = 0, color = \"%s\"];\n", list->free, list->free, freeColor);
+    fprintf(dotFile, "}\n");
+    fclose(dotFile);
+
+    sprintf(buffer, "dot logs/dot/listXorDump_%zu.dot -Tsvg -o logs/img/xorDumpImg_%zu.svg",
+            imgNumber, imgNumber);
+    system(buffer);
+
+    logPrint(L_ZERO, 0, "<object width=\"87%%\" type=\"image/svg+xml\" data=\"img/xorDumpImg_%zu.svg\"></object>", imgNumber);
+    logPrint(L_ZERO, 0, "\n<hr>\n");
+    logFlush();
+
+    return LIST_SUCCESS;
+}
+
+listXorCursor_t listXorBegin(listXor_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    listXorCursor_t cursor = {NULL_LIST_IT, list->first};
+    return cursor;
+}
+
+listXorCursor_t listXorEnd(listXor_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    return listXorEndOf(list);
+}
+
+listXorCursor_t listXorLast(listXor_t *list) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    listXorCursor_t cursor = listXorEndOf(list);
+    listXorPrev(list, &cursor);
+    return cursor;
+}
+
+listIterator_t listXorNext(listXor_t *list, listXorCursor_t *cursor) {
+    MY_ASSERT(list,   exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(cursor, exit(LIST_NULL_PTR_ERROR));
+    if (!listXorCursorIsValid(list, *cursor)) {
+        logPrint(L_DEBUG, 0, "Invalid cursor (%d, %d) passed in listXorNext\n", cursor->prev, cursor->cur);
+        return INVALID_LIST_IT;
+    }
+
+    listIterator_t nextSlot = list->link[cursor->cur] ^ cursor->prev;
+    cursor->prev = cursor->cur;
+    cursor->cur  = nextSlot;
+    return nextSlot;
+}
+
+listIterator_t listXorPrev(listXor_t *list, listXorCursor_t *cursor) {
+    MY_ASSERT(list,   exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(cursor, exit(LIST_NULL_PTR_ERROR));
+    if (!listXorCursorIsValid(list, *cursor)) {
+        logPrint(L_DEBUG, 0, "Invalid cursor (%d, %d) passed in listXorPrev\n", cursor->prev, cursor->cur);
+        return INVALID_LIST_IT;
+    }
+
+    listIterator_t prevSlot = list->link[cursor->prev] ^ cursor->cur;
+    cursor->cur  = cursor->prev;
+    cursor->prev = prevSlot;
+    return cursor->cur;
+}
+
+void *listXorGet(listXor_t *list, listXorCursor_t cursor) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    if (cursor.cur == NULL_LIST_IT || !listXorCursorIsValid(list, cursor))
+        return NULL;
+    return listXorDataOf(list, cursor.cur);
+}
+
+listIterator_t listXorInsert(listXor_t *list, listXorCursor_t *cursor, const void *elem) {
+    MY_ASSERT(list,   exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(cursor, exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(elem,   exit(LIST_NULL_PTR_ERROR));
+    LIST_XOR_ASSERT(list, *cursor, INVALID_LIST_IT);
+
+    if (!listXorCursorIsValid(list, *cursor)) {
+        logPrint(L_DEBUG, 0, "Invalid cursor (%d, %d) passed in listXorInsert\n", cursor->prev, cursor->cur);
+        return INVALID_LIST_IT;
+    }
+
+    listIterator_t slot = listXorTakeSlot(list);
+    if (slot == NULL_LIST_IT)
+        return INVALID_LIST_IT;
+
+    memcpy(listXorDataOf(list, slot), elem, list->elemSize);
+
+    // prev and cur swap each other for new slot, in empty list both are NULL element and nothing changes
+    list->link[slot] = cursor->prev ^ cursor->cur;
+    list->link[cursor->prev] ^= cursor->cur  ^ slot;
+    list->link[cursor->cur]  ^= cursor->prev ^ slot;
+    if (cursor->prev == NULL_LIST_IT)
+        list->first = slot;
+    list->size++;
+
+    cursor->cur = slot;
+
+    LIST_XOR_ASSERT(list, *cursor, INVALID_LIST_IT);
+    return slot;
+}
+
+enum listStatus listXorRemove(listXor_t *list, listXorCursor_t *cursor, void *elem) {
+    MY_ASSERT(list,   exit(LIST_NULL_PTR_ERROR));
+    MY_ASSERT(cursor, exit(LIST_NULL_PTR_ERROR));
+    LIST_XOR_ASSERT(list, *cursor, status);
+
+    if (cursor->cur == NULL_LIST_IT || !listXorCursorIsValid(list, *cursor)) {
+        logPrint(L_DEBUG, 0, "Invalid cursor (%d, %d) passed in listXorRemove of xor list[%p]\n",
+                             cursor->prev, cursor->cur, list);
+        return LIST_ERROR;
+    }
+
+    listIterator_t slot     = cursor->cur,
+                   nextSlot = list->link[slot] ^ cursor->prev;
+    if (elem)
+        memcpy(elem, listXorDataOf(list, slot), list->elemSize);
+
+    list->link[cursor->prev] ^= slot ^ nextSlot;
+    list->link[nextSlot]     ^= slot ^ cursor->prev;
+    if (cursor->prev == NULL_LIST_IT)
+        list->first = nextSlot;
+    list->size--;
+
+    list->link[slot] = ~list->free;
+    list->free = slot;
+
+    cursor->cur = nextSlot;
+
+    LIST_XOR_ASSERT(list, *cursor, status);
+    return LIST_SUCCESS;
+}
+
+listIterator_t listXorPushBack(listXor_t *list, const void *elem) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    listXorCursor_t cursor = listXorEndOf(list);
+    return listXorInsert(list, &cursor, elem);
+}
+
+listIterator_t listXorPushFront(listXor_t *list, const void *elem) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    listXorCursor_t cursor = {NULL_LIST_IT, list->first};
+    return listXorInsert(list, &cursor, elem);
+}
+
+enum listStatus listXorPopBack(listXor_t *list, void *elem) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    if (list->size == 0) {
+        logPrint(L_DEBUG, 0, "Attempt to pop from empty xor list[%p]\n", list);
+        return LIST_ERROR;
+    }
+
+    listIterator_t last = list->link[0] ^ list->first;
+    listXorCursor_t cursor = {list->link[last] ^ NULL_LIST_IT, last};
+    return listXorRemove(list, &cursor, elem);
+}
+
+enum listStatus listXorPopFront(listXor_t *list, void *elem) {
+    MY_ASSERT(list, exit(LIST_NULL_PTR_ERROR));
+    if (list->size == 0) {
+        logPrint(L_DEBUG, 0, "Attempt to pop from empty xor list[%p]\n", list);
+        return LIST_ERROR;
+    }
+
+    listXorCursor_t cursor = {NULL_LIST_IT, list->first};
+    return listXorRemove(list, &cursor, elem);
+}
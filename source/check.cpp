@@ -0,0 +1,504 @@
+/// @file
+/// @brief Self-checks of library parts that unit dumps can't show: threads, files, queues
+/// Build and run with `make check`, exit code is nonzero if any check fails
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "error_debug.h"
+#include "logger.h"
+#include "argvProcessor.h"
+#include "cList.h"
+#include "cListShared.h"
+#include "cListQueue.h"
+
+/// @brief Print reason of failed check, used as return value of check functions
+static bool checkFailed(const char *reason) {
+    printf("    %s\n", reason);
+    return false;
+}
+
+/*------------------SHARED LIST STRESS----------------------------------------*/
+// Readers of listShared_t traverse, look up and copy elements while writer
+// moves elements and grows and shrinks storage under exclusive lock. Every
+// update keeps set of values, so any reader that sees another sum, size or
+// value has seen a torn list. Writer verifies list after every update.
+
+/// Elements of stressed list, values are 0 .. SHARED_CHECK_SIZE - 1
+const int32_t  SHARED_CHECK_SIZE    = 1000;
+const size_t   SHARED_CHECK_READERS = 4;
+const uint32_t SHARED_CHECK_UPDATES = 2000;
+/// Every SHARED_CHECK_GROWTH-th update reallocates storage
+const uint32_t SHARED_CHECK_GROWTH  = 16;
+
+typedef struct sharedCheckUpdate {
+    std::mt19937 *rng;
+    uint32_t      number;
+    uint32_t      verifyFailures;
+} sharedCheckUpdate_t;
+
+/// @brief Move random element after another one, sometimes grow and shrink storage, then verify list
+static enum listStatus sharedCheckUpdater(cList_t *list, void *ctx) {
+    sharedCheckUpdate_t *update = (sharedCheckUpdate_t *) ctx;
+    std::mt19937 &rng = *update->rng;
+
+    listIterator_t moved = listAt(list, (int32_t) (rng() % (uint32_t) list->size));
+    int64_t value = *(int64_t *) listDataOf(list, moved);
+    listRemove(list, moved);
+    listInsertAfter(list, listAt(list, (int32_t) (rng() % (uint32_t) list->size)), &value);
+
+    if (++update->number % SHARED_CHECK_GROWTH == 0) {
+        // batch of fresh elements forces reallocation, it is removed before readers run again
+        int32_t batch = list->reserved - list->size + 1;
+        int64_t extra = -1;
+        listIterator_t first = listPushBack(list, &extra);
+        for (int32_t idx = 1; idx < batch; idx++)
+            listPushBack(list, &extra);
+        listRemoveRange(list, first, listPrevOf(list, 0));
+        listShrinkToFit(list, NULL);
+    }
+
+    if (listVerify(list) != LIST_SUCCESS)
+        update->verifyFailures++;
+    return LIST_SUCCESS;
+}
+
+typedef struct sharedCheckSum {
+    int64_t sum;
+    int32_t count;
+} sharedCheckSum_t;
+
+static int sharedCheckVisitor(const void *elem, listIterator_t, void *ctx) {
+    sharedCheckSum_t *sum = (sharedCheckSum_t *) ctx;
+    sum->sum += *(const int64_t *) elem;
+    sum->count++;
+    return 0;
+}
+
+static bool checkShared() {
+    listShared_t shared = {};
+    listSharedCtor(&shared, sizeof(int64_t), NULL, LIST_LAYOUT_SOA);
+    int64_t expected = 0;
+    for (int64_t value = 0; value < SHARED_CHECK_SIZE; value++) {
+        listSharedPushBack(&shared, &value);
+        expected += value;
+    }
+
+    std::atomic<bool>     writerDone(false);
+    std::atomic<uint32_t> tornReads(0);
+    std::mt19937 writerRng(2024);
+    sharedCheckUpdate_t update = {&writerRng, 0, 0};
+
+    std::vector<std::thread> readers;
+    for (size_t reader = 0; reader < SHARED_CHECK_READERS; reader++)
+        readers.emplace_back([&shared, &writerDone, &tornReads, expected, reader]() {
+            std::mt19937 rng((uint32_t) reader);
+            // at least one pass runs after writer is done
+            bool lastPass = false;
+            while (!lastPass) {
+                lastPass = writerDone.load(std::memory_order_acquire);
+
+                sharedCheckSum_t sum = {0, 0};
+                listSharedForEach(&shared, sharedCheckVisitor, &sum);
+                if (sum.sum != expected || sum.count != SHARED_CHECK_SIZE ||
+                    listSharedSize(&shared) != SHARED_CHECK_SIZE)
+                    tornReads++;
+
+                int64_t value = (int64_t) (rng() % (uint32_t) SHARED_CHECK_SIZE), copy = -1;
+                listIterator_t found = listSharedFind(&shared, &value);
+                if (found == INVALID_LIST_IT)
+                    tornReads++;
+                // element may be moved between calls, but any copy must be one of values
+                if (listSharedGet(&shared, found, &copy) == LIST_SUCCESS &&
+                    !(copy >= 0 && copy < SHARED_CHECK_SIZE))
+                    tornReads++;
+                // lock prefers readers, writer would starve if they never stepped aside
+                std::this_thread::yield();
+            }
+        });
+
+    for (uint32_t idx = 0; idx < SHARED_CHECK_UPDATES; idx++) {
+        listSharedUpdate(&shared, sharedCheckUpdater, &update);
+        std::this_thread::yield();
+    }
+    writerDone.store(true, std::memory_order_release);
+    for (std::thread &reader : readers)
+        reader.join();
+
+    bool finalValid = (listVerify(&shared.list) == LIST_SUCCESS);
+    listSharedDtor(&shared);
+
+    if (tornReads)
+        return checkFailed("readers saw inconsistent list");
+    if (update.verifyFailures || !finalValid)
+        return checkFailed("listVerify failed after update");
+    return true;
+}
+
+/*------------------QUEUE ORDER-----------------------------------------------*/
+// Producers push numbered items through small queue, so both full and empty
+// queue are waited out many times. Consumer must get every item exactly once
+// and items of one producer in order they were pushed.
+
+const int32_t  QUEUE_CHECK_CAPACITY = 16;
+const uint32_t QUEUE_CHECK_ITEMS    = 20000;    ///< Items of every producer
+const uint32_t QUEUE_CHECK_MAX_PRODUCERS = 4;
+
+typedef struct queueCheckItem {
+    uint32_t producer;
+    uint32_t number;
+} queueCheckItem_t;
+
+static bool checkQueueMode(enum listQueueMode mode, uint32_t producers) {
+    listQueue_t queue = {};
+    if (listQueueCtor(&queue, sizeof(queueCheckItem_t), QUEUE_CHECK_CAPACITY, mode) != LIST_SUCCESS)
+        return checkFailed("queue construction failed");
+
+    std::atomic<uint32_t> producersLeft(producers);
+    std::vector<std::thread> threads;
+    for (uint32_t producer = 0; producer < producers; producer++)
+        threads.emplace_back([&queue, &producersLeft, producer]() {
+            for (uint32_t number = 0; number < QUEUE_CHECK_ITEMS; number++) {
+                queueCheckItem_t item = {producer, number};
+                while (!listQueueTryPush(&queue, &item))
+                    std::this_thread::yield();
+            }
+            producersLeft.fetch_sub(1, std::memory_order_release);
+        });
+
+    // queue found empty after all producers finished means items were lost
+    std::vector<uint32_t> expected(producers, 0);
+    uint32_t received = 0, misplaced = 0;
+    while (received < producers * QUEUE_CHECK_ITEMS) {
+        queueCheckItem_t item = {};
+        if (!listQueueTryPop(&queue, &item)) {
+            if (producersLeft.load(std::memory_order_acquire) == 0 && !listQueueTryPop(&queue, &item))
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+        received++;
+        if (item.producer >= producers || item.number != expected[item.producer])
+            misplaced++;
+        else
+            expected[item.producer]++;
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+
+    queueCheckItem_t extra = {};
+    bool drained  = !listQueueTryPop(&queue, &extra);
+    bool verified = (listQueueVerify(&queue) == LIST_SUCCESS);
+    listQueueDtor(&queue);
+
+    if (misplaced)
+        return checkFailed("items were duplicated or reordered within producer");
+    if (received != producers * QUEUE_CHECK_ITEMS || !drained)
+        return checkFailed("items were lost or duplicated");
+    if (!verified)
+        return checkFailed("listQueueVerify failed after run");
+    return true;
+}
+
+static bool checkQueue() {
+    if (!checkQueueMode(LIST_QUEUE_SPSC, 1))
+        return false;
+    for (uint32_t producers = 1; producers <= QUEUE_CHECK_MAX_PRODUCERS; producers *= 2)
+        if (!checkQueueMode(LIST_QUEUE_MPSC, producers))
+            return false;
+    return true;
+}
+
+/*------------------LIST COMPARISON-------------------------------------------*/
+
+/// @brief Check that lists hold equal payloads in the same order and have the same slots
+static bool listsAreEqual(cList_t *list, cList_t *other) {
+    if (list->size != other->size || list->elemSize != other->elemSize)
+        return false;
+    listIterator_t iter = listNextOf(list, 0), otherIter = listNextOf(other, 0);
+    for (; iter != NULL_LIST_IT && otherIter != NULL_LIST_IT;
+           iter = listNextOf(list, iter), otherIter = listNextOf(other, otherIter)) {
+        if (iter != otherIter || memcmp(listDataOf(list, iter), listDataOf(other, otherIter), list->elemSize) != 0)
+            return false;
+    }
+    return iter == NULL_LIST_IT && otherIter == NULL_LIST_IT;
+}
+
+/// @brief Fill list with count random values, removals leave free slots between elements
+static void fillScrambled(cList_t *list, std::mt19937 &rng, int32_t count) {
+    for (int32_t idx = 0; idx < count; idx++) {
+        int64_t value = (int64_t) rng();
+        if (list->size > 0 && rng() % 2)
+            listInsertAfter(list, listAt(list, (int32_t) (rng() % (uint32_t) list->size)), &value);
+        else
+            listPushFront(list, &value);
+        if (rng() % 4 == 0)
+            listRemove(list, listAt(list, (int32_t) (rng() % (uint32_t) list->size)));
+    }
+}
+
+/*------------------SAVE AND MAP----------------------------------------------*/
+// Saved then mapped list must equal the original slot by slot in both layouts.
+// Files with wrong magic or version and files cut short must be refused.
+
+/// File written by file checks, removed after them
+static const char *CHECK_LIST_FILE = "checkList.bin";
+/// Offsets of magic and version in list file header
+const long LIST_FILE_MAGIC_OFFSET   = 0;
+const long LIST_FILE_VERSION_OFFSET = 8;
+
+/// @brief Overwrite bytes of file at offset
+static bool patchFile(const char *path, long offset, const void *bytes, size_t size) {
+    FILE *file = fopen(path, "r+b");
+    if (!file)
+        return false;
+    bool patched = fseek(file, offset, SEEK_SET) == 0 && fwrite(bytes, 1, size, file) == size;
+    return (fclose(file) == 0) && patched;
+}
+
+/// @brief Check that damaged copy of saved list isn't mapped
+static bool fileIsRefused(cList_t *list) {
+    cList_t mapped = {};
+    if (listMapFile(&mapped, CHECK_LIST_FILE, NULL) == LIST_SUCCESS) {
+        listDtor(&mapped);
+        return false;
+    }
+    // file is saved again, so next damage is applied to good file
+    return listSaveToFile(list, CHECK_LIST_FILE) == LIST_SUCCESS;
+}
+
+static bool checkFileLayout(enum listLayout layout) {
+    std::mt19937 rng(layout);
+    cList_t list = {};
+    listCtor(&list, sizeof(int64_t), NULL, layout);
+    listSetVerifyLevel(&list, LIST_VERIFY_LOCAL, 0);
+    fillScrambled(&list, rng, 5000);
+
+    if (listSaveToFile(&list, CHECK_LIST_FILE) != LIST_SUCCESS) {
+        listDtor(&list);
+        return checkFailed("listSaveToFile failed");
+    }
+    cList_t mapped = {};
+    if (listMapFile(&mapped, CHECK_LIST_FILE, NULL) != LIST_SUCCESS) {
+        listDtor(&list);
+        return checkFailed("listMapFile failed");
+    }
+    bool equal = mapped.layout == layout && mapped.reserved == list.reserved && mapped.free == list.free &&
+                 mapped.untouched == list.untouched && listVerify(&mapped) == LIST_SUCCESS &&
+                 listsAreEqual(&list, &mapped);
+    // mapping is private, writes to mapped list don't reach file
+    int64_t value = -1;
+    listPushBack(&mapped, &value);
+    listRemove(&mapped, listNextOf(&mapped, 0));
+    listDtor(&mapped);
+    if (!equal) {
+        listDtor(&list);
+        return checkFailed("mapped list differs from saved one");
+    }
+    if (listMapFile(&mapped, CHECK_LIST_FILE, NULL) != LIST_SUCCESS || !listsAreEqual(&list, &mapped)) {
+        listDtor(&mapped);
+        listDtor(&list);
+        return checkFailed("writes to mapped list changed file");
+    }
+    listDtor(&mapped);
+
+    const char     badMagic[8] = {'n', 'o', 't', 'A', 'L', 'i', 's', 't'};
+    const uint32_t badVersion  = 0xFFFF;
+    bool refused = patchFile(CHECK_LIST_FILE, LIST_FILE_MAGIC_OFFSET, badMagic, sizeof(badMagic)) &&
+                   fileIsRefused(&list) &&
+                   patchFile(CHECK_LIST_FILE, LIST_FILE_VERSION_OFFSET, &badVersion, sizeof(badVersion)) &&
+                   fileIsRefused(&list) &&
+                   // file shorter than header and file with storage block cut in the middle
+                   truncate(CHECK_LIST_FILE, 100) == 0 && fileIsRefused(&list) &&
+                   truncate(CHECK_LIST_FILE, 4096 + 100) == 0 && fileIsRefused(&list);
+    listDtor(&list);
+    remove(CHECK_LIST_FILE);
+    if (!refused)
+        return checkFailed("damaged list file was mapped");
+    return true;
+}
+
+static bool checkFile() {
+    return checkFileLayout(LIST_LAYOUT_SOA) && checkFileLayout(LIST_LAYOUT_AOS);
+}
+
+/*------------------JOURNAL REPLAY--------------------------------------------*/
+// Snapshot plus journal replayed into new list must equal live list slot by slot:
+// after random operations, after checkpoint that crashed between snapshot and
+// journal restart (old or empty journal), and with last record torn by crash.
+
+static const char *CHECK_SNAPSHOT_FILE = "checkSnapshot.bin";
+static const char *CHECK_JOURNAL_FILE  = "checkJournal.bin";
+
+static int compareInt64(const void *a, const void *b) {
+    int64_t left = *(const int64_t *) a, right = *(const int64_t *) b;
+    return (left > right) - (left < right);
+}
+
+/// @brief Apply count random journaled operations to list
+static void journalOperations(cList_t *list, std::mt19937 &rng, int32_t count) {
+    for (int32_t idx = 0; idx < count; idx++) {
+        int64_t value = (int64_t) rng();
+        listIterator_t some = list->size ? listAt(list, (int32_t) (rng() % (uint32_t) list->size)) : NULL_LIST_IT;
+        switch (rng() % 16) {
+            case 0:  case 1:  case 2:  listInsertAfter(list, some, &value);    break;
+            case 3:  case 4:           listPushFront(list, &value);            break;
+            case 5:  case 6:  case 7:  if (some != NULL_LIST_IT) listRemove(list, some); break;
+            case 8: {
+                int64_t batch[8] = {value, value + 1, value + 2, value + 3, value + 4, value + 5, value + 6, value + 7};
+                listPushBackBulk(list, batch, 8);
+                break;
+            }
+            case 9:  if (some != NULL_LIST_IT) listSplice(list, NULL_LIST_IT, list, some, some); break;
+            case 10: if (rng() % 8 == 0) listLinearize(list);                   break;
+            case 11: if (rng() % 8 == 0) listShrinkToFit(list, NULL);           break;
+            case 12: if (rng() % 8 == 0) listSort(list, compareInt64);          break;
+            case 13: if (rng() % 8 == 0) listSortLinearize(list, compareInt64); break;
+            case 14: if (rng() % 64 == 0) listClear(list);                      break;
+            default: listPushBack(list, &value);                               break;
+        }
+    }
+}
+
+/// @brief Replay snapshot and journal files and compare result with list
+static bool replayMatches(cList_t *list) {
+    cList_t replayed = {};
+    if (listJournalReplay(&replayed, CHECK_SNAPSHOT_FILE, CHECK_JOURNAL_FILE, NULL) != LIST_SUCCESS)
+        return false;
+    bool equal = listVerify(&replayed) == LIST_SUCCESS && listsAreEqual(list, &replayed) &&
+                 replayed.free == list->free && replayed.untouched == list->untouched;
+    listDtor(&replayed);
+    return equal;
+}
+
+static off_t fileSize(const char *path) {
+    struct stat fileStat = {};
+    return (stat(path, &fileStat) == 0) ? fileStat.st_size : -1;
+}
+
+static bool checkJournalLayout(enum listLayout layout) {
+    std::mt19937 rng(layout);
+    cList_t list = {};
+    listCtor(&list, sizeof(int64_t), NULL, layout);
+    listSetVerifyLevel(&list, LIST_VERIFY_LOCAL, 0);
+    fillScrambled(&list, rng, 500);
+
+    const char *failure = NULL;
+    if (listSaveToFile(&list, CHECK_SNAPSHOT_FILE) != LIST_SUCCESS ||
+        listJournalAttach(&list, CHECK_JOURNAL_FILE) != LIST_SUCCESS)
+        failure = "can't start journal";
+
+    if (!failure) {
+        journalOperations(&list, rng, 2000);
+        listJournalSync(&list);
+        if (!replayMatches(&list))
+            failure = "replayed list differs from live one";
+    }
+
+    // first half of listJournalCheckpoint: snapshot of next generation is durable,
+    // journal of previous generation is left behind by crash
+    if (!failure) {
+        list.generation++;
+        if (listSaveToFile(&list, CHECK_SNAPSHOT_FILE) != LIST_SUCCESS || !replayMatches(&list))
+            failure = "journal older than snapshot was replayed";
+        else if (truncate(CHECK_JOURNAL_FILE, 0) != 0 || !replayMatches(&list))
+            failure = "empty journal after snapshot wasn't skipped";
+        // second half of checkpoint, journal restarts
+        listJournalDetach(&list);
+        if (!failure && listJournalAttach(&list, CHECK_JOURNAL_FILE) != LIST_SUCCESS)
+            failure = "can't restart journal";
+    }
+
+    if (!failure) {
+        journalOperations(&list, rng, 1000);
+        if (listJournalCheckpoint(&list, CHECK_SNAPSHOT_FILE) != LIST_SUCCESS)
+            failure = "checkpoint failed";
+        journalOperations(&list, rng, 1000);
+        listJournalSync(&list);
+        if (!failure && !replayMatches(&list))
+            failure = "replayed list differs from live one after checkpoint";
+    }
+
+    // crash in the middle of last record: replay stops before it
+    if (!failure) {
+        cList_t before = {};
+        listClone(&before, &list);
+        off_t sizeBefore = fileSize(CHECK_JOURNAL_FILE);
+
+        int64_t batch[64] = {};
+        for (int64_t &value : batch)
+            value = (int64_t) rng();
+        listPushBackBulk(&list, batch, sizeof(batch) / sizeof(batch[0]));
+        listJournalDetach(&list);
+        off_t sizeAfter = fileSize(CHECK_JOURNAL_FILE);
+
+        if (sizeBefore < 0 || sizeAfter <= sizeBefore ||
+            truncate(CHECK_JOURNAL_FILE, sizeBefore + (sizeAfter - sizeBefore) / 2) != 0 || !replayMatches(&before))
+            failure = "journal with torn record wasn't replayed up to it";
+        listDtor(&before);
+    }
+
+    if (list.journal)
+        listJournalDetach(&list);
+    listDtor(&list);
+    remove(CHECK_SNAPSHOT_FILE);
+    remove(CHECK_JOURNAL_FILE);
+    if (failure)
+        return checkFailed(failure);
+    return true;
+}
+
+static bool checkJournal() {
+    return checkJournalLayout(LIST_LAYOUT_SOA) && checkJournalLayout(LIST_LAYOUT_AOS);
+}
+
+/*------------------MAIN------------------------------------------------------*/
+
+typedef struct namedCheck {
+    const char *name;
+    bool (*run)();
+} namedCheck_t;
+
+static const namedCheck_t CHECKS[] = {
+    {"shared",  checkShared},
+    {"queue",   checkQueue},
+    {"file",    checkFile},
+    {"journal", checkJournal},
+};
+
+int main(int argc, const char *argv[]) {
+    logOpen("check.txt", L_TXT_MODE);
+    setLogLevel(L_ZERO);
+
+    enableHelpFlag("cList self-checks, exit code is nonzero if any check fails\n");
+    registerFlag(TYPE_STRING, "-c", "--check", "run only given check (shared, queue, file, journal)");
+    enum argvStatus argvRes = processArgs(argc, argv);
+    if (argvRes != ARGV_SUCCESS) {
+        logClose();
+        return (argvRes == ARGV_HELP_MSG) ? 0 : 1;
+    }
+    const char *onlyCheck = isFlagSet("-c") ? getFlagValue("-c").string_ : NULL;
+
+    size_t failed = 0;
+    for (const namedCheck_t &check : CHECKS) {
+        if (onlyCheck && strcmp(onlyCheck, check.name) != 0)
+            continue;
+        bool passed = check.run();
+        printf("%-12s %s\n", check.name, passed ? "ok" : "FAILED");
+        fflush(stdout);
+        if (!passed)
+            failed++;
+    }
+
+    logClose();
+    return failed ? 1 : 0;
+}